@@ -0,0 +1,575 @@
+/*
+ File: AsyncReader.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <AsyncReader.h>
+
+// C++
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+//----------------------------------------------------------------
+AsyncReader::AsyncReader(const std::wstring &filename, const bool direct)
+#ifdef _WIN32
+: m_handle    {INVALID_HANDLE_VALUE}
+#else
+: m_descriptor{-1}
+#endif
+, m_direct    {false}
+, m_begin     {0}
+, m_readBegin {0}
+, m_end       {0}
+{
+#ifdef _WIN32
+  if(direct)
+  {
+    m_handle = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, nullptr);
+    m_direct = (m_handle != INVALID_HANDLE_VALUE);
+  }
+
+  if(m_handle == INVALID_HANDLE_VALUE)
+    m_handle = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+#else
+  const auto path = std::filesystem::path(filename);
+
+#ifdef O_DIRECT
+  if(direct)
+  {
+    // some file systems don't support direct I/O, the file is read through the cache then.
+    m_descriptor = ::open(path.c_str(), O_RDONLY|O_DIRECT);
+    m_direct = (m_descriptor != -1);
+  }
+#endif
+
+  if(m_descriptor == -1)
+    m_descriptor = ::open(path.c_str(), O_RDONLY);
+
+#ifdef F_NOCACHE
+  if(direct && m_descriptor != -1)
+    m_direct = (fcntl(m_descriptor, F_NOCACHE, 1) != -1);
+#endif
+#endif
+
+  m_buffer = BufferPool::instance().acquire(QUEUE_DEPTH * READ_BLOCK_SIZE);
+}
+
+//----------------------------------------------------------------
+AsyncReader::~AsyncReader()
+{
+#ifdef _WIN32
+  if(m_handle != INVALID_HANDLE_VALUE) CloseHandle(m_handle);
+#else
+  if(m_descriptor != -1) ::close(m_descriptor);
+#endif
+}
+
+//----------------------------------------------------------------
+bool AsyncReader::isOpen() const
+{
+#ifdef _WIN32
+  return m_handle != INVALID_HANDLE_VALUE;
+#else
+  return m_descriptor != -1;
+#endif
+}
+
+//----------------------------------------------------------------
+bool AsyncReader::prepareRange(unsigned long long begin, unsigned long long end)
+{
+  m_error.clear();
+
+  if(!isOpen())
+  {
+    m_error = "Unable to open the file as readonly.";
+    return false;
+  }
+
+  if(!m_buffer)
+  {
+    m_error = "Unable to allocate the read buffers.";
+    return false;
+  }
+
+  m_begin     = begin;
+  m_end       = std::max(begin, end);
+  m_readBegin = m_direct ? begin - (begin % AlignedBuffer::ALIGNMENT) : begin;
+
+  return true;
+}
+
+//----------------------------------------------------------------
+unsigned long long AsyncReader::blocks() const
+{
+  if(m_begin >= m_end) return 0;
+
+  return (m_end - m_readBegin + READ_BLOCK_SIZE - 1) / READ_BLOCK_SIZE;
+}
+
+//----------------------------------------------------------------
+size_t AsyncReader::blockNeeded(unsigned long long block) const
+{
+  return static_cast<size_t>(std::min<unsigned long long>(READ_BLOCK_SIZE, m_end - blockPosition(block)));
+}
+
+//----------------------------------------------------------------
+size_t AsyncReader::blockReadSize(unsigned long long block) const
+{
+  const auto needed = blockNeeded(block);
+  if(!m_direct) return needed;
+
+  // the unaligned tail of the file is read with a full sector, the read stops at the end of the file.
+  return ((needed + AlignedBuffer::ALIGNMENT - 1) / AlignedBuffer::ALIGNMENT) * AlignedBuffer::ALIGNMENT;
+}
+
+//----------------------------------------------------------------
+long long AsyncReader::readAt(unsigned char *buffer, size_t size, unsigned long long position) const
+{
+  size_t done = 0;
+  while(done < size)
+  {
+#ifdef _WIN32
+    OVERLAPPED overlapped;
+    std::memset(&overlapped, 0, sizeof(overlapped));
+    overlapped.Offset     = static_cast<DWORD>((position + done) & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>((position + done) >> 32);
+
+    DWORD bytesRead = 0;
+    const auto toRead = static_cast<DWORD>(std::min<size_t>(size - done, 0x40000000));
+    if(!ReadFile(m_handle, buffer + done, toRead, &bytesRead, &overlapped))
+      return GetLastError() == ERROR_HANDLE_EOF ? static_cast<long long>(done) : -1;
+#else
+    const auto bytesRead = ::pread(m_descriptor, buffer + done, size - done, position + done);
+    if(bytesRead < 0)
+    {
+      if(errno == EINTR) continue;
+      return -1;
+    }
+#endif
+
+    if(bytesRead == 0) break;
+    done += bytesRead;
+  }
+
+  return done;
+}
+
+//----------------------------------------------------------------
+PrefetchReader::PrefetchReader(const std::wstring &filename, const bool direct)
+: AsyncReader(filename, direct)
+, m_blocks   {0}
+, m_read     {0}
+, m_consumed {0}
+, m_stop     {false}
+{
+}
+
+//----------------------------------------------------------------
+PrefetchReader::~PrefetchReader()
+{
+  stop();
+}
+
+//----------------------------------------------------------------
+bool PrefetchReader::setRange(unsigned long long begin, unsigned long long end)
+{
+  stop();
+
+  if(!prepareRange(begin, end)) return false;
+
+  m_blocks   = blocks();
+  m_read     = 0;
+  m_consumed = 0;
+  m_stop     = false;
+  m_readError.clear();
+
+  if(m_blocks > 0) m_thread = std::thread(&PrefetchReader::readBlocks, this);
+
+  return true;
+}
+
+//----------------------------------------------------------------
+bool PrefetchReader::next(const unsigned char *&data, size_t &size)
+{
+  if(m_consumed >= m_blocks) return false;
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this]() { return m_read > m_consumed || !m_readError.empty(); });
+
+    if(m_read <= m_consumed)
+    {
+      m_error = m_readError;
+      return false;
+    }
+
+    const auto skip = blockSkip(m_consumed);
+    data = slotBuffer(m_consumed % QUEUE_DEPTH) + skip;
+    size = blockNeeded(m_consumed) - skip;
+
+    // the buffer given in the last call is free again.
+    ++m_consumed;
+  }
+  m_condition.notify_all();
+
+  return true;
+}
+
+//----------------------------------------------------------------
+void PrefetchReader::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_condition.notify_all();
+
+  if(m_thread.joinable()) m_thread.join();
+}
+
+//----------------------------------------------------------------
+void PrefetchReader::readBlocks()
+{
+  for(unsigned long long block = 0; block < m_blocks; ++block)
+  {
+    {
+      // the buffer of the last block given to the consumer is in use until the next call.
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this, block]() { return m_stop || block + (m_consumed > 0 ? 1 : 0) < m_consumed + QUEUE_DEPTH; });
+
+      if(m_stop) return;
+    }
+
+    const auto position = blockPosition(block);
+    const auto result   = readAt(slotBuffer(block % QUEUE_DEPTH), blockReadSize(block), position);
+    const auto failed   = result < static_cast<long long>(blockNeeded(block));
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if(failed)
+        m_readError = "I/O error reading the file at position " + std::to_string(position + std::max(0LL, result)) + ".";
+      else
+        ++m_read;
+    }
+    m_condition.notify_all();
+
+    if(failed) return;
+  }
+}
+
+#ifdef __linux__
+
+//----------------------------------------------------------------
+std::unique_ptr<UringReader> UringReader::create(const std::wstring &filename, const bool direct)
+{
+  std::unique_ptr<UringReader> reader(new UringReader(filename, direct));
+  if(!reader->initialize()) return nullptr;
+
+  return reader;
+}
+
+//----------------------------------------------------------------
+UringReader::UringReader(const std::wstring &filename, const bool direct)
+: AsyncReader (filename, direct)
+, m_ring      {-1}
+, m_sqRing    {nullptr}
+, m_sqRingSize{0}
+, m_cqRing    {nullptr}
+, m_cqRingSize{0}
+, m_sqes      {nullptr}
+, m_sqesSize  {0}
+, m_sqTail    {nullptr}
+, m_sqMask    {nullptr}
+, m_sqArray   {nullptr}
+, m_cqHead    {nullptr}
+, m_cqTail    {nullptr}
+, m_cqMask    {nullptr}
+, m_cqes      {nullptr}
+, m_queued    {0}
+, m_registered{false}
+, m_current   {0}
+, m_given     {false}
+, m_next      {0}
+{
+}
+
+//----------------------------------------------------------------
+UringReader::~UringReader()
+{
+  if(m_ring != -1)
+  {
+    drain();
+
+    if(m_registered) syscall(__NR_io_uring_register, m_ring, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+  }
+
+  if(m_sqes)   munmap(m_sqes, m_sqesSize);
+  if(m_cqRing) munmap(m_cqRing, m_cqRingSize);
+  if(m_sqRing) munmap(m_sqRing, m_sqRingSize);
+
+  if(m_ring != -1) ::close(m_ring);
+}
+
+//----------------------------------------------------------------
+bool UringReader::initialize()
+{
+  if(!isOpen() || !m_buffer) return false;
+
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+
+  m_ring = syscall(__NR_io_uring_setup, QUEUE_DEPTH, &params);
+  if(m_ring < 0)
+  {
+    m_ring = -1;
+    return false;
+  }
+
+  auto mapRing = [this](size_t size, off_t offset) -> void *
+  {
+    auto address = mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, m_ring, offset);
+    return address == MAP_FAILED ? nullptr : address;
+  };
+
+  m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+  m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  m_sqesSize   = params.sq_entries * sizeof(io_uring_sqe);
+
+  m_sqRing = mapRing(m_sqRingSize, IORING_OFF_SQ_RING);
+  m_cqRing = mapRing(m_cqRingSize, IORING_OFF_CQ_RING);
+  m_sqes   = mapRing(m_sqesSize, IORING_OFF_SQES);
+  if(!m_sqRing || !m_cqRing || !m_sqes) return false;
+
+  auto sq = static_cast<unsigned char *>(m_sqRing);
+  m_sqTail  = reinterpret_cast<unsigned int *>(sq + params.sq_off.tail);
+  m_sqMask  = reinterpret_cast<unsigned int *>(sq + params.sq_off.ring_mask);
+  m_sqArray = reinterpret_cast<unsigned int *>(sq + params.sq_off.array);
+
+  auto cq = static_cast<unsigned char *>(m_cqRing);
+  m_cqHead = reinterpret_cast<unsigned int *>(cq + params.cq_off.head);
+  m_cqTail = reinterpret_cast<unsigned int *>(cq + params.cq_off.tail);
+  m_cqMask = reinterpret_cast<unsigned int *>(cq + params.cq_off.ring_mask);
+  m_cqes   = cq + params.cq_off.cqes;
+
+  m_requests.assign(QUEUE_DEPTH, Request{0, 0, 0, false});
+
+  // registered buffers avoid mapping their pages on every read, but can fail if the
+  // locked memory limit is low. Plain reads are used in that case.
+  std::vector<iovec> vectors;
+  for(size_t i = 0; i < QUEUE_DEPTH; ++i)
+    vectors.push_back(iovec{slotBuffer(i), READ_BLOCK_SIZE});
+
+  m_registered = (0 == syscall(__NR_io_uring_register, m_ring, IORING_REGISTER_BUFFERS, vectors.data(), vectors.size()));
+
+  return m_registered || supportsRead();
+}
+
+//----------------------------------------------------------------
+bool UringReader::supportsRead() const
+{
+  // plain reads and the probe were added at the same time, kernels without the probe don't support them.
+  const unsigned int operations = 256;
+  std::vector<unsigned char> buffer(sizeof(io_uring_probe) + operations * sizeof(io_uring_probe_op), 0);
+  auto probe = reinterpret_cast<io_uring_probe *>(buffer.data());
+
+  if(0 != syscall(__NR_io_uring_register, m_ring, IORING_REGISTER_PROBE, probe, operations)) return false;
+
+  return probe->last_op >= IORING_OP_READ && (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED);
+}
+
+//----------------------------------------------------------------
+bool UringReader::setRange(unsigned long long begin, unsigned long long end)
+{
+  drain();
+
+  if(!prepareRange(begin, end)) return false;
+
+  m_next    = 0;
+  m_current = 0;
+  m_given   = false;
+
+  for(size_t i = 0; i < QUEUE_DEPTH; ++i)
+    queue(i);
+
+  if(!submit(0))
+  {
+    m_error = std::string("Unable to read the file: ") + std::strerror(errno);
+    return false;
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------
+bool UringReader::next(const unsigned char *&data, size_t &size)
+{
+  if(m_given)
+  {
+    // the slot given in the last call is free again, read the next block in it while the
+    // data of the others is parsed.
+    queue(m_current);
+    m_current = (m_current + 1) % QUEUE_DEPTH;
+    m_given   = false;
+
+    if(m_queued > 0 && !submit(0))
+    {
+      m_error = std::string("Unable to read the file: ") + std::strerror(errno);
+      return false;
+    }
+  }
+
+  auto &request = m_requests[m_current];
+  if(request.size == 0) return false;
+
+  reap();
+  while(request.inFlight)
+  {
+    if(!submit(1))
+    {
+      m_error = std::string("Unable to read the file: ") + std::strerror(errno);
+      return false;
+    }
+
+    reap();
+  }
+
+  const auto needed   = blockNeeded(request.block);
+  const auto position = blockPosition(request.block);
+  auto buffer = slotBuffer(m_current);
+
+  if(request.result >= 0 && static_cast<size_t>(request.result) < needed)
+  {
+    // short read, complete the block synchronously.
+    const auto result = readAt(buffer + request.result, request.size - request.result, position + request.result);
+    request.result = result < 0 ? result : request.result + result;
+  }
+
+  if(request.result < static_cast<long long>(needed))
+  {
+    m_error = "I/O error reading the file at position " + std::to_string(position + std::max(0LL, request.result)) + ".";
+    return false;
+  }
+
+  const auto skip = blockSkip(request.block);
+  data    = buffer + skip;
+  size    = needed - skip;
+  m_given = true;
+
+  return true;
+}
+
+//----------------------------------------------------------------
+void UringReader::queue(size_t slot)
+{
+  auto &request = m_requests[slot];
+  request = Request{0, 0, 0, false};
+
+  if(m_next >= blocks()) return;
+
+  request.block    = m_next++;
+  request.size     = blockReadSize(request.block);
+  request.inFlight = true;
+
+  const auto tail  = *m_sqTail;
+  const auto index = tail & *m_sqMask;
+
+  auto entry = static_cast<io_uring_sqe *>(m_sqes) + index;
+  std::memset(entry, 0, sizeof(io_uring_sqe));
+  entry->opcode    = m_registered ? IORING_OP_READ_FIXED : IORING_OP_READ;
+  entry->fd        = m_descriptor;
+  entry->addr      = reinterpret_cast<unsigned long long>(slotBuffer(slot));
+  entry->len       = static_cast<unsigned int>(request.size);
+  entry->off       = blockPosition(request.block);
+  entry->buf_index = m_registered ? static_cast<unsigned short>(slot) : 0;
+  entry->user_data = slot;
+
+  m_sqArray[index] = index;
+  __atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+  ++m_queued;
+}
+
+//----------------------------------------------------------------
+bool UringReader::submit(unsigned int wait)
+{
+  while(true)
+  {
+    const auto flags  = wait > 0 ? IORING_ENTER_GETEVENTS : 0;
+    const auto result = syscall(__NR_io_uring_enter, m_ring, m_queued, wait, flags, nullptr, 0);
+    if(result >= 0)
+    {
+      m_queued -= std::min<unsigned int>(m_queued, result);
+      return true;
+    }
+
+    if(errno != EINTR) return false;
+  }
+}
+
+//----------------------------------------------------------------
+void UringReader::reap()
+{
+  auto head = *m_cqHead;
+  while(head != __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE))
+  {
+    const auto entry = static_cast<io_uring_cqe *>(m_cqes) + (head & *m_cqMask);
+    if(entry->user_data < m_requests.size())
+    {
+      auto &request = m_requests[entry->user_data];
+      request.result   = entry->res;
+      request.inFlight = false;
+    }
+
+    ++head;
+  }
+
+  __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+}
+
+//----------------------------------------------------------------
+void UringReader::drain()
+{
+  auto inFlight = [this]()
+  {
+    return std::any_of(m_requests.cbegin(), m_requests.cend(), [](const Request &request) { return request.inFlight; });
+  };
+
+  reap();
+  while(inFlight())
+  {
+    if(!submit(1)) break;
+    reap();
+  }
+}
+
+#endif // __linux__
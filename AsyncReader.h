@@ -0,0 +1,290 @@
+/*
+ File: AsyncReader.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ASYNCREADER_H_
+#define ASYNCREADER_H_
+
+// Project
+#include <BlockReader.h>
+#include <BufferPool.h>
+
+// C++
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \class AsyncReader
+ * \brief Base of the readers that keep several blocks of the range read ahead of the
+ *        consumer in a page aligned buffer from the pool. In direct mode the file is
+ *        read bypassing the system cache, the reads are aligned and the bytes outside
+ *        of the range are not given to the consumer.
+ *
+ */
+class AsyncReader
+: public BlockReader
+{
+  public:
+    static constexpr size_t QUEUE_DEPTH     = 8;       /** number of blocks read ahead.  */
+    static constexpr size_t READ_BLOCK_SIZE = 1048576; /** 1 MB blocks, 8 MB in flight. */
+
+    /** \brief AsyncReader class virtual destructor.
+     *
+     */
+    virtual ~AsyncReader();
+
+    /** \brief Returns true if the file is read without the system cache.
+     *
+     */
+    bool isDirect() const
+    { return m_direct; }
+
+  protected:
+    /** \brief AsyncReader class constructor.
+     * \param[in] filename File name.
+     * \param[in] direct True to read the file bypassing the system cache.
+     *
+     */
+    AsyncReader(const std::wstring &filename, const bool direct);
+
+    /** \brief Returns true if the file is open.
+     *
+     */
+    bool isOpen() const;
+
+    /** \brief Sets the range and the aligned reading start. Returns false on error.
+     * \param[in] begin Range beginning position.
+     * \param[in] end Range ending position.
+     *
+     */
+    bool prepareRange(unsigned long long begin, unsigned long long end);
+
+    /** \brief Returns the number of blocks of the current range.
+     *
+     */
+    unsigned long long blocks() const;
+
+    /** \brief Returns the file position of the given block.
+     * \param[in] block Block index.
+     *
+     */
+    unsigned long long blockPosition(unsigned long long block) const
+    { return m_readBegin + block * READ_BLOCK_SIZE; }
+
+    /** \brief Returns the number of bytes of the given block needed to cover the range.
+     * \param[in] block Block index.
+     *
+     */
+    size_t blockNeeded(unsigned long long block) const;
+
+    /** \brief Returns the number of bytes to read for the given block, aligned in direct mode.
+     * \param[in] block Block index.
+     *
+     */
+    size_t blockReadSize(unsigned long long block) const;
+
+    /** \brief Returns the number of bytes at the beginning of the block that are before the range.
+     * \param[in] block Block index.
+     *
+     */
+    size_t blockSkip(unsigned long long block) const
+    { return block == 0 ? static_cast<size_t>(m_begin - m_readBegin) : 0; }
+
+    /** \brief Returns the buffer of the given slot of the queue.
+     * \param[in] slot Slot index.
+     *
+     */
+    unsigned char *slotBuffer(size_t slot) const
+    { return m_buffer->data() + slot * READ_BLOCK_SIZE; }
+
+    /** \brief Reads from the given position until the buffer is full or the end of the file.
+     *         Returns the number of bytes read or -1 on error.
+     * \param[in] buffer Buffer pointer.
+     * \param[in] size Number of bytes to read.
+     * \param[in] position File position.
+     *
+     */
+    long long readAt(unsigned char *buffer, size_t size, unsigned long long position) const;
+
+#ifdef _WIN32
+    void                          *m_handle;     /** file handle.                          */
+#else
+    int                            m_descriptor; /** file descriptor.                      */
+#endif
+    bool                           m_direct;     /** true if reading without system cache. */
+    std::shared_ptr<AlignedBuffer> m_buffer;     /** buffer of the blocks of the queue.    */
+    unsigned long long             m_begin;      /** range beginning position.             */
+    unsigned long long             m_readBegin;  /** aligned position of the first block.  */
+    unsigned long long             m_end;        /** range ending position.                */
+};
+
+/** \class PrefetchReader
+ * \brief Reads the blocks of the range ahead of the consumer in a background thread using
+ *        positional reads, keeping a fixed number of buffers filled so the parsing of a
+ *        block overlaps with the reading of the next ones.
+ *
+ */
+class PrefetchReader
+: public AsyncReader
+{
+  public:
+    /** \brief PrefetchReader class constructor.
+     * \param[in] filename File name.
+     * \param[in] direct True to read the file bypassing the system cache.
+     *
+     */
+    explicit PrefetchReader(const std::wstring &filename, const bool direct = false);
+
+    /** \brief PrefetchReader class virtual destructor.
+     *
+     */
+    virtual ~PrefetchReader();
+
+    virtual bool setRange(unsigned long long begin, unsigned long long end) override;
+    virtual bool next(const unsigned char *&data, size_t &size) override;
+
+  private:
+    /** \brief Stops the reading thread and waits for it to finish.
+     *
+     */
+    void stop();
+
+    /** \brief Reads the blocks of the range until the end or until stopped.
+     *
+     */
+    void readBlocks();
+
+    std::thread             m_thread;    /** reading thread.                            */
+    std::mutex              m_mutex;     /** protects the block counters and the error. */
+    std::condition_variable m_condition; /** signals read and released blocks.          */
+    unsigned long long      m_blocks;    /** number of blocks of the range.             */
+    unsigned long long      m_read;      /** number of blocks read by the thread.       */
+    unsigned long long      m_consumed;  /** number of blocks given to the consumer.    */
+    bool                    m_stop;      /** true to stop the reading thread.           */
+    std::string             m_readError; /** error message of the reading thread.       */
+};
+
+#ifdef __linux__
+
+/** \class UringReader
+ * \brief Reads the blocks of the range with io_uring, keeping several reads into registered
+ *        buffers in flight so the device queue stays busy while the blocks are parsed.
+ *
+ */
+class UringReader
+: public AsyncReader
+{
+  public:
+    /** \brief Returns a reader of the given file or nullptr if the file can't be opened or the
+     *         system doesn't support io_uring.
+     * \param[in] filename File name.
+     * \param[in] direct True to read the file bypassing the system cache.
+     *
+     */
+    static std::unique_ptr<UringReader> create(const std::wstring &filename, const bool direct = false);
+
+    /** \brief UringReader class virtual destructor.
+     *
+     */
+    virtual ~UringReader();
+
+    virtual bool setRange(unsigned long long begin, unsigned long long end) override;
+    virtual bool next(const unsigned char *&data, size_t &size) override;
+
+  private:
+    /** \brief UringReader class constructor.
+     * \param[in] filename File name.
+     * \param[in] direct True to read the file bypassing the system cache.
+     *
+     */
+    UringReader(const std::wstring &filename, const bool direct);
+
+    /** \brief Creates the ring and registers the buffers. Returns false on error or if the buffers
+     *         can't be registered and the system doesn't support plain reads.
+     *
+     */
+    bool initialize();
+
+    /** \brief Returns true if the system supports reads into buffers that are not registered.
+     *
+     */
+    bool supportsRead() const;
+
+    /** \brief Queues the read of the next block of the range in the given slot, if any.
+     * \param[in] slot Slot index.
+     *
+     */
+    void queue(size_t slot);
+
+    /** \brief Submits the queued reads and waits for the given number of completions.
+     *         Returns false on error.
+     * \param[in] wait Number of completions to wait for.
+     *
+     */
+    bool submit(unsigned int wait);
+
+    /** \brief Processes the completed reads.
+     *
+     */
+    void reap();
+
+    /** \brief Waits for all the reads in flight.
+     *
+     */
+    void drain();
+
+    /** \struct Request
+     * \brief Read of a block into a slot of the queue.
+     *
+     */
+    struct Request
+    {
+      unsigned long long block;    /** block index in the range.                      */
+      size_t             size;     /** requested bytes, 0 if the slot has no block.   */
+      long long          result;   /** bytes read or negative error, when completed.  */
+      bool               inFlight; /** true if submitted and not completed.           */
+    };
+
+    int                  m_ring;       /** io_uring file descriptor.                        */
+    void                *m_sqRing;     /** submission queue ring mapping.                   */
+    size_t               m_sqRingSize; /** submission queue ring mapping size.              */
+    void                *m_cqRing;     /** completion queue ring mapping.                   */
+    size_t               m_cqRingSize; /** completion queue ring mapping size.              */
+    void                *m_sqes;       /** submission queue entries mapping.                */
+    size_t               m_sqesSize;   /** submission queue entries mapping size.           */
+    unsigned int        *m_sqTail;     /** submission queue tail.                           */
+    unsigned int        *m_sqMask;     /** submission queue index mask.                     */
+    unsigned int        *m_sqArray;    /** submission queue index array.                    */
+    unsigned int        *m_cqHead;     /** completion queue head.                           */
+    unsigned int        *m_cqTail;     /** completion queue tail.                           */
+    unsigned int        *m_cqMask;     /** completion queue index mask.                     */
+    void                *m_cqes;       /** completion queue entries.                        */
+    unsigned int         m_queued;     /** reads queued and not submitted yet.              */
+    bool                 m_registered; /** true if the buffers are registered in the ring.  */
+    std::vector<Request> m_requests;   /** read of every slot.                              */
+    size_t               m_current;    /** slot of the next block to give.                  */
+    bool                 m_given;      /** true if the current slot was given already.      */
+    unsigned long long   m_next;       /** index of the next block to queue.                */
+};
+
+#endif // __linux__
+
+#endif // ASYNCREADER_H_
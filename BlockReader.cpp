@@ -0,0 +1,161 @@
+/*
+ File: BlockReader.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <BlockReader.h>
+#include <AsyncReader.h>
+
+// C++
+#include <algorithm>
+#include <filesystem>
+
+const unsigned long long BUFFER_SIZE = 5242880; /** 5 MB size buffer, also the size of mapped blocks. */
+
+//----------------------------------------------------------------
+std::unique_ptr<BlockReader> BlockReader::create(const std::wstring &filename, const ReadMode mode)
+{
+  if(mode == ReadMode::MAPPED)
+  {
+    auto file = MappedFile::open(filename);
+    if(file) return std::make_unique<MappedReader>(file);
+  }
+
+  if(mode == ReadMode::ASYNC || mode == ReadMode::DIRECT)
+  {
+    const auto direct = (mode == ReadMode::DIRECT);
+
+#ifdef __linux__
+    auto reader = UringReader::create(filename, direct);
+    if(reader) return reader;
+#endif
+
+    return std::make_unique<PrefetchReader>(filename, direct);
+  }
+
+  return std::make_unique<BufferedReader>(filename);
+}
+
+//----------------------------------------------------------------
+BufferedReader::BufferedReader(const std::wstring &filename)
+: m_file    {std::filesystem::path(filename), std::ios_base::in|std::ios_base::binary}
+, m_position{0}
+, m_end     {0}
+{
+}
+
+//----------------------------------------------------------------
+bool BufferedReader::setRange(unsigned long long begin, unsigned long long end)
+{
+  m_error.clear();
+
+  if(!m_file.is_open())
+  {
+    m_error = "Unable to open the file as readonly.";
+    return false;
+  }
+
+  if(m_buffer.empty()) m_buffer.resize(BUFFER_SIZE);
+
+  m_file.clear();
+  m_file.seekg(begin);
+  m_position = begin;
+  m_end      = end;
+
+  return true;
+}
+
+//----------------------------------------------------------------
+bool BufferedReader::next(const unsigned char *&data, size_t &size)
+{
+  if(m_position >= m_end) return false;
+
+  const auto toRead = std::min<unsigned long long>(m_buffer.size(), m_end - m_position);
+  m_file.read(reinterpret_cast<char *>(m_buffer.data()), toRead);
+  const auto bytesRead = static_cast<unsigned long long>(m_file.gcount());
+
+  if(bytesRead != toRead)
+  {
+    m_error = "I/O error reading the file at position " + std::to_string(m_position + bytesRead) + ".";
+    return false;
+  }
+
+  data = m_buffer.data();
+  size = bytesRead;
+  m_position += bytesRead;
+
+  return true;
+}
+
+//----------------------------------------------------------------
+MappedReader::MappedReader(std::shared_ptr<MappedFile> file)
+: m_file    {file}
+, m_windowAt{0}
+, m_position{0}
+, m_end     {0}
+{
+}
+
+//----------------------------------------------------------------
+bool MappedReader::setRange(unsigned long long begin, unsigned long long end)
+{
+  m_error.clear();
+
+  if(end > m_file->size())
+  {
+    m_error = "Range outside of the file.";
+    return false;
+  }
+
+  m_window   = nullptr;
+  m_position = begin;
+  m_end      = end;
+
+  return true;
+}
+
+//----------------------------------------------------------------
+bool MappedReader::next(const unsigned char *&data, size_t &size)
+{
+  if(m_position >= m_end) return false;
+
+  if(!m_window || m_position >= m_windowAt + m_window->size())
+  {
+    // map the next window, the whole range if the file is fully mapped.
+    const auto windowSize = m_file->isFullyMapped() ? m_end - m_position : std::min<unsigned long long>(MappedFile::windowSize(), m_end - m_position);
+
+    m_window = nullptr;
+    m_window = m_file->map(m_position, windowSize);
+    if(!m_window)
+    {
+      m_error = "Unable to map the file at position " + std::to_string(m_position) + ".";
+      return false;
+    }
+
+    m_window->adviseSequential();
+    m_windowAt = m_position;
+  }
+
+  // blocks of the buffer size to keep the same progress granularity.
+  const auto offset = m_position - m_windowAt;
+  size = std::min<unsigned long long>(BUFFER_SIZE, m_window->size() - offset);
+  data = m_window->data() + offset;
+  m_position += size;
+
+  return true;
+}
@@ -0,0 +1,146 @@
+/*
+ File: BlockReader.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BLOCKREADER_H_
+#define BLOCKREADER_H_
+
+// Project
+#include <MappedFile.h>
+
+// C++
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/** \brief Ways of reading the container when scanning. Asynchronous reads use io_uring on
+ *         Linux and a prefetching thread on other systems. Direct reads are asynchronous
+ *         reads that bypass the system cache, if the file system allows it.
+ *
+ */
+enum class ReadMode: char { BUFFERED = 0, MAPPED, ASYNC, DIRECT };
+
+/** \class BlockReader
+ * \brief Reads a range of a file in consecutive blocks.
+ *
+ */
+class BlockReader
+{
+  public:
+    /** \brief Returns a reader of the given file using the given mode, or a buffered reader if the
+     *         mode is not available for the file.
+     * \param[in] filename File name.
+     * \param[in] mode Read mode.
+     *
+     */
+    static std::unique_ptr<BlockReader> create(const std::wstring &filename, const ReadMode mode);
+
+    /** \brief BlockReader class virtual destructor.
+     *
+     */
+    virtual ~BlockReader()
+    {}
+
+    /** \brief Sets the range [begin, end) of the file to read. Returns false on error.
+     * \param[in] begin Range beginning position.
+     * \param[in] end Range ending position.
+     *
+     */
+    virtual bool setRange(unsigned long long begin, unsigned long long end) = 0;
+
+    /** \brief Returns the next block of the range. Returns false at the end of the range or on
+     *         error. The block data is valid until the next call.
+     * \param[out] data Block data pointer.
+     * \param[out] size Block size in bytes.
+     *
+     */
+    virtual bool next(const unsigned char *&data, size_t &size) = 0;
+
+    /** \brief Returns the error message of the last operation or an empty string if there was no error.
+     *
+     */
+    const std::string &error() const
+    { return m_error; }
+
+  protected:
+    std::string m_error; /** error message of the last operation. */
+};
+
+/** \class BufferedReader
+ * \brief Reads the file blocks into a buffer using a file stream.
+ *
+ */
+class BufferedReader
+: public BlockReader
+{
+  public:
+    /** \brief BufferedReader class constructor.
+     * \param[in] filename File name.
+     *
+     */
+    explicit BufferedReader(const std::wstring &filename);
+
+    /** \brief BufferedReader class virtual destructor.
+     *
+     */
+    virtual ~BufferedReader()
+    {}
+
+    virtual bool setRange(unsigned long long begin, unsigned long long end) override;
+    virtual bool next(const unsigned char *&data, size_t &size) override;
+
+  private:
+    std::ifstream              m_file;     /** file stream.                */
+    std::vector<unsigned char> m_buffer;   /** read buffer.                */
+    unsigned long long         m_position; /** next position to read.      */
+    unsigned long long         m_end;      /** range ending position.      */
+};
+
+/** \class MappedReader
+ * \brief Returns the file blocks directly from the memory mapping of the file, without copies.
+ *
+ */
+class MappedReader
+: public BlockReader
+{
+  public:
+    /** \brief MappedReader class constructor.
+     * \param[in] file File mapping.
+     *
+     */
+    explicit MappedReader(std::shared_ptr<MappedFile> file);
+
+    /** \brief MappedReader class virtual destructor.
+     *
+     */
+    virtual ~MappedReader()
+    {}
+
+    virtual bool setRange(unsigned long long begin, unsigned long long end) override;
+    virtual bool next(const unsigned char *&data, size_t &size) override;
+
+  private:
+    std::shared_ptr<MappedFile>               m_file;     /** file mapping.                          */
+    std::shared_ptr<const MappedFile::Region> m_window;   /** currently mapped window of the range.  */
+    unsigned long long                        m_windowAt; /** position of the window in the file.    */
+    unsigned long long                        m_position; /** next position to read.                 */
+    unsigned long long                        m_end;      /** range ending position.                 */
+};
+
+#endif // BLOCKREADER_H_
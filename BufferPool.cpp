@@ -0,0 +1,115 @@
+/*
+ File: BufferPool.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <BufferPool.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+//----------------------------------------------------------------
+AlignedBuffer::AlignedBuffer(size_t size)
+: m_data{nullptr}
+, m_size{size}
+, m_huge{false}
+{
+  if(size == 0) return;
+
+#ifdef _WIN32
+  // large pages need a privilege the user rarely has, use normal pages.
+  m_data = static_cast<unsigned char *>(VirtualAlloc(nullptr, size, MEM_COMMIT|MEM_RESERVE, PAGE_READWRITE));
+#else
+#ifdef MAP_HUGETLB
+  if(size % HUGE_PAGE_SIZE == 0)
+  {
+    auto address = mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+    if(address != MAP_FAILED)
+    {
+      m_data = static_cast<unsigned char *>(address);
+      m_huge = true;
+      return;
+    }
+  }
+#endif
+
+  auto address = mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+  if(address == MAP_FAILED) return;
+
+  m_data = static_cast<unsigned char *>(address);
+
+#ifdef MADV_HUGEPAGE
+  // no reserved huge pages, transparent huge pages can still back the buffer.
+  if(size % HUGE_PAGE_SIZE == 0) madvise(address, size, MADV_HUGEPAGE);
+#endif
+#endif
+}
+
+//----------------------------------------------------------------
+AlignedBuffer::~AlignedBuffer()
+{
+  if(!m_data) return;
+
+#ifdef _WIN32
+  VirtualFree(m_data, 0, MEM_RELEASE);
+#else
+  munmap(m_data, m_size);
+#endif
+}
+
+//----------------------------------------------------------------
+BufferPool &BufferPool::instance()
+{
+  static BufferPool pool;
+
+  return pool;
+}
+
+//----------------------------------------------------------------
+std::shared_ptr<AlignedBuffer> BufferPool::acquire(size_t size)
+{
+  std::unique_ptr<AlignedBuffer> buffer;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_free.find(size);
+    if(it != m_free.end())
+    {
+      buffer = std::move(it->second);
+      m_free.erase(it);
+    }
+  }
+
+  if(!buffer)
+  {
+    buffer = std::make_unique<AlignedBuffer>(size);
+    if(!buffer->data()) return nullptr;
+  }
+
+  return std::shared_ptr<AlignedBuffer>(buffer.release(), [this](AlignedBuffer *released) { release(released); });
+}
+
+//----------------------------------------------------------------
+void BufferPool::release(AlignedBuffer *buffer)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_free.emplace(buffer->size(), std::unique_ptr<AlignedBuffer>(buffer));
+}
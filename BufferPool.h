@@ -0,0 +1,117 @@
+/*
+ File: BufferPool.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUFFERPOOL_H_
+#define BUFFERPOOL_H_
+
+// C++
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** \class AlignedBuffer
+ * \brief Buffer allocated directly from the system, aligned to the memory page size so it
+ *        can be used for direct I/O. Buffers with a size multiple of the huge page size are
+ *        backed by huge pages when the system has them available.
+ *
+ */
+class AlignedBuffer
+{
+  public:
+    static constexpr size_t ALIGNMENT      = 4096;    /** minimum alignment of the buffer data. */
+    static constexpr size_t HUGE_PAGE_SIZE = 2097152; /** huge page size.                       */
+
+    /** \brief AlignedBuffer class constructor.
+     * \param[in] size Buffer size in bytes.
+     *
+     */
+    explicit AlignedBuffer(size_t size);
+
+    /** \brief AlignedBuffer class virtual destructor.
+     *
+     */
+    virtual ~AlignedBuffer();
+
+    /** \brief Returns the buffer data or nullptr if it couldn't be allocated.
+     *
+     */
+    unsigned char *data() const
+    { return m_data; }
+
+    /** \brief Returns the size of the buffer in bytes.
+     *
+     */
+    size_t size() const
+    { return m_size; }
+
+    /** \brief Returns true if the buffer is backed by huge pages.
+     *
+     */
+    bool isHuge() const
+    { return m_huge; }
+
+  private:
+    AlignedBuffer(const AlignedBuffer &) = delete;
+    AlignedBuffer &operator=(const AlignedBuffer &) = delete;
+
+    unsigned char *m_data; /** buffer data.                  */
+    size_t         m_size; /** buffer size in bytes.         */
+    bool           m_huge; /** true if backed by huge pages. */
+};
+
+/** \class BufferPool
+ * \brief Keeps the released aligned buffers to give them again instead of allocating new
+ *        ones, the readers of all the scanning threads share the same pool.
+ *
+ */
+class BufferPool
+{
+  public:
+    /** \brief Returns the pool instance.
+     *
+     */
+    static BufferPool &instance();
+
+    /** \brief Returns a buffer of the given size, or nullptr if it can't be allocated. The buffer
+     *         returns to the pool when the last reference is destroyed.
+     * \param[in] size Buffer size in bytes.
+     *
+     */
+    std::shared_ptr<AlignedBuffer> acquire(size_t size);
+
+  private:
+    /** \brief BufferPool class constructor.
+     *
+     */
+    BufferPool()
+    {}
+
+    /** \brief Adds the given buffer to the free buffers of the pool.
+     * \param[in] buffer Released buffer.
+     *
+     */
+    void release(AlignedBuffer *buffer);
+
+    std::mutex                                            m_mutex; /** protects the free buffers. */
+    std::multimap<size_t, std::unique_ptr<AlignedBuffer>> m_free;  /** free buffers by size.      */
+};
+
+#endif // BUFFERPOOL_H_
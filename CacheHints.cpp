@@ -0,0 +1,140 @@
+/*
+ File: CacheHints.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <CacheHints.h>
+
+// C++
+#include <algorithm>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(POSIX_FADV_DONTNEED) && defined(POSIX_FADV_WILLNEED)
+#define CACHE_HINTS_SUPPORTED
+#endif
+
+//----------------------------------------------------------------
+CacheHints::CacheHints(const std::wstring &filename, const unsigned long long window, const bool readAhead)
+: m_descriptor{-1}
+, m_window    {window}
+, m_readAhead {readAhead}
+, m_begin     {0}
+, m_end       {0}
+, m_released  {0}
+, m_requested {0}
+{
+#ifdef CACHE_HINTS_SUPPORTED
+  // the advice applies to the cached pages of the file, not to the descriptor used to read it.
+  if(m_window > 0)
+    m_descriptor = ::open(std::filesystem::path(filename).c_str(), O_RDONLY);
+#endif
+}
+
+//----------------------------------------------------------------
+CacheHints::~CacheHints()
+{
+#ifdef CACHE_HINTS_SUPPORTED
+  if(m_descriptor != -1)
+  {
+    // the pages that were being read when released the first time are still cached.
+    if(m_begin < m_end) posix_fadvise(m_descriptor, m_begin, m_end - m_begin, POSIX_FADV_DONTNEED);
+
+    ::close(m_descriptor);
+  }
+#endif
+}
+
+//----------------------------------------------------------------
+bool CacheHints::isEnabled() const
+{
+  return m_descriptor != -1;
+}
+
+//----------------------------------------------------------------
+void CacheHints::setRange(unsigned long long begin, unsigned long long end)
+{
+  m_begin     = begin;
+  m_end       = end;
+  m_released  = begin;
+  m_requested = begin;
+
+  advance(begin);
+}
+
+//----------------------------------------------------------------
+void CacheHints::advance(unsigned long long position)
+{
+#ifdef CACHE_HINTS_SUPPORTED
+  if(m_descriptor == -1) return;
+
+  // the pages behind the position are released in steps of a quarter of the window and half
+  // of the window is requested ahead, so the file never takes more than the window.
+  const auto step = std::max(1ULL, m_window / 4);
+  if(position >= m_released + step)
+  {
+    posix_fadvise(m_descriptor, m_released, position - m_released, POSIX_FADV_DONTNEED);
+    m_released = position;
+  }
+
+  const auto ahead = std::min(m_end, position + m_window / 2);
+  if(m_readAhead && (ahead >= m_requested + step || (ahead == m_end && ahead > m_requested)))
+  {
+    const auto from = std::max(m_requested, position);
+    posix_fadvise(m_descriptor, from, ahead - from, POSIX_FADV_WILLNEED);
+    m_requested = ahead;
+  }
+#else
+  (void)position;
+#endif
+}
+
+//----------------------------------------------------------------
+void CacheHints::drop(const std::wstring &filename, unsigned long long begin, unsigned long long end)
+{
+#ifdef CACHE_HINTS_SUPPORTED
+  const auto descriptor = ::open(std::filesystem::path(filename).c_str(), O_RDONLY);
+  if(descriptor == -1) return;
+
+  posix_fadvise(descriptor, begin, end > begin ? end - begin : 0, POSIX_FADV_DONTNEED);
+  ::close(descriptor);
+#else
+  (void)filename;
+  (void)begin;
+  (void)end;
+#endif
+}
+
+//----------------------------------------------------------------
+void CacheHints::dropWritten(const std::wstring &filename)
+{
+#ifdef CACHE_HINTS_SUPPORTED
+  const auto descriptor = ::open(std::filesystem::path(filename).c_str(), O_RDONLY);
+  if(descriptor == -1) return;
+
+  fdatasync(descriptor);
+  posix_fadvise(descriptor, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(descriptor);
+#else
+  (void)filename;
+#endif
+}
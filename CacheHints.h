@@ -0,0 +1,95 @@
+/*
+ File: CacheHints.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CACHEHINTS_H_
+#define CACHEHINTS_H_
+
+// C++
+#include <string>
+
+/** \class CacheHints
+ * \brief Gives the system hints about the use of the cached pages of a file read
+ *        sequentially: the pages ahead of the read position are requested in advance
+ *        and the pages behind it are released, so the file occupies at most a window
+ *        of the system cache. Does nothing on systems without file advice support.
+ *
+ */
+class CacheHints
+{
+  public:
+    /** \brief CacheHints class constructor.
+     * \param[in] filename File name.
+     * \param[in] window Maximum size in bytes of the file in the cache, 0 to disable the hints.
+     * \param[in] readAhead True to request the pages ahead, false if the file is read without the cache.
+     *
+     */
+    CacheHints(const std::wstring &filename, const unsigned long long window, const bool readAhead = true);
+
+    /** \brief CacheHints class virtual destructor. Releases the pages of the range.
+     *
+     */
+    virtual ~CacheHints();
+
+    /** \brief Returns true if the hints are given to the system.
+     *
+     */
+    bool isEnabled() const;
+
+    /** \brief Sets the range of the file that is going to be read.
+     * \param[in] begin Range beginning position.
+     * \param[in] end Range ending position.
+     *
+     */
+    void setRange(unsigned long long begin, unsigned long long end);
+
+    /** \brief Updates the hints after the data before the given position has been processed.
+     * \param[in] position Read position.
+     *
+     */
+    void advance(unsigned long long position);
+
+    /** \brief Releases the cached pages of the given range of a file.
+     * \param[in] filename File name.
+     * \param[in] begin Range beginning position.
+     * \param[in] end Range ending position, 0 for the end of the file.
+     *
+     */
+    static void drop(const std::wstring &filename, unsigned long long begin = 0, unsigned long long end = 0);
+
+    /** \brief Stores the written data of a file and releases its cached pages, as the pages
+     *         waiting to be written can't be released.
+     * \param[in] filename File name.
+     *
+     */
+    static void dropWritten(const std::wstring &filename);
+
+  private:
+    CacheHints(const CacheHints &) = delete;
+    CacheHints &operator=(const CacheHints &) = delete;
+
+    int                m_descriptor; /** file descriptor, -1 if not enabled.         */
+    unsigned long long m_window;     /** maximum size of the file in the cache.      */
+    bool               m_readAhead;  /** true to request the pages ahead.            */
+    unsigned long long m_begin;      /** range beginning position.                   */
+    unsigned long long m_end;        /** range ending position.                      */
+    unsigned long long m_released;   /** pages before this position are released.    */
+    unsigned long long m_requested;  /** pages before this position were requested.  */
+};
+
+#endif // CACHEHINTS_H_
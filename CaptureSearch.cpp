@@ -0,0 +1,232 @@
+/*
+ File: CaptureSearch.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <CaptureSearch.h>
+
+// C++
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CAPTURE_SEARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+  const unsigned char CAPTURE_PATTERN[5] = { 'O', 'g', 'g', 'S', 0 }; /** capture pattern and version. */
+  const size_t        CAPTURE_SIZE       = sizeof(CAPTURE_PATTERN);   /** capture pattern size.        */
+
+  //----------------------------------------------------------------
+  size_t fullPatternEnd(size_t size, size_t limit)
+  {
+    // positions lower than this one have all the pattern bytes available.
+    return std::min(limit, size < CAPTURE_SIZE ? 0 : size - CAPTURE_SIZE + 1);
+  }
+
+  //----------------------------------------------------------------
+  size_t findScalar(const unsigned char *data, size_t size, size_t position, size_t limit)
+  {
+    const auto end = fullPatternEnd(size, limit);
+
+    while(position < end)
+    {
+      auto candidate = reinterpret_cast<const unsigned char *>(std::memchr(data + position, CAPTURE_PATTERN[0], end - position));
+      if(!candidate)
+      {
+        position = end;
+        break;
+      }
+
+      position = candidate - data;
+      if(0 == std::memcmp(candidate, CAPTURE_PATTERN, CAPTURE_SIZE)) return position;
+
+      ++position;
+    }
+
+    // partial matches at the end of the data.
+    for(; position < limit; ++position)
+    {
+      if(0 == std::memcmp(data + position, CAPTURE_PATTERN, std::min(size - position, CAPTURE_SIZE))) return position;
+    }
+
+    return limit;
+  }
+
+#ifdef CAPTURE_SEARCH_X86
+  //----------------------------------------------------------------
+  size_t verifyMask(const unsigned char *data, size_t position, unsigned long long mask)
+  {
+    // the vector kernels only compare the 'O' and 'S' bytes, check the rest of the pattern.
+    while(mask)
+    {
+      const auto candidate = position + __builtin_ctzll(mask);
+      if(0 == std::memcmp(data + candidate, CAPTURE_PATTERN, CAPTURE_SIZE)) return candidate;
+
+      mask &= mask - 1;
+    }
+
+    return std::string::npos;
+  }
+
+  //----------------------------------------------------------------
+  __attribute__((target("sse2")))
+  size_t findSSE2(const unsigned char *data, size_t size, size_t position, size_t limit)
+  {
+    const auto end = fullPatternEnd(size, limit);
+    const auto first = _mm_set1_epi8(static_cast<char>(CAPTURE_PATTERN[0]));
+    const auto last  = _mm_set1_epi8(static_cast<char>(CAPTURE_PATTERN[3]));
+
+    while(position + 16 <= end)
+    {
+      auto ptr = data + position;
+      const auto match = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)), first),
+                                       _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + 3)), last));
+
+      const unsigned int mask = _mm_movemask_epi8(match);
+      if(mask)
+      {
+        const auto found = verifyMask(data, position, mask);
+        if(found != std::string::npos) return found;
+      }
+
+      position += 16;
+    }
+
+    return findScalar(data, size, position, limit);
+  }
+
+  //----------------------------------------------------------------
+  __attribute__((target("avx2")))
+  size_t findAVX2(const unsigned char *data, size_t size, size_t position, size_t limit)
+  {
+    const auto end = fullPatternEnd(size, limit);
+    const auto first = _mm256_set1_epi8(static_cast<char>(CAPTURE_PATTERN[0]));
+    const auto last  = _mm256_set1_epi8(static_cast<char>(CAPTURE_PATTERN[3]));
+
+    while(position + 64 <= end)
+    {
+      auto ptr = data + position;
+      const auto matchLow  = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)), first),
+                                              _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr + 3)), last));
+      const auto matchHigh = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr + 32)), first),
+                                              _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr + 35)), last));
+
+      if(!_mm256_testz_si256(_mm256_or_si256(matchLow, matchHigh), _mm256_or_si256(matchLow, matchHigh)))
+      {
+        const unsigned long long mask = static_cast<unsigned int>(_mm256_movemask_epi8(matchLow)) |
+                                        (static_cast<unsigned long long>(static_cast<unsigned int>(_mm256_movemask_epi8(matchHigh))) << 32);
+        const auto found = verifyMask(data, position, mask);
+        if(found != std::string::npos) return found;
+      }
+
+      position += 64;
+    }
+
+    return findSSE2(data, size, position, limit);
+  }
+
+  //----------------------------------------------------------------
+  __attribute__((target("avx512f,avx512bw")))
+  size_t findAVX512(const unsigned char *data, size_t size, size_t position, size_t limit)
+  {
+    const auto end = fullPatternEnd(size, limit);
+    const auto first = _mm512_set1_epi8(static_cast<char>(CAPTURE_PATTERN[0]));
+    const auto last  = _mm512_set1_epi8(static_cast<char>(CAPTURE_PATTERN[3]));
+
+    while(position + 128 <= end)
+    {
+      auto ptr = data + position;
+      const auto maskLow  = _mm512_mask_cmpeq_epi8_mask(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(ptr), first), _mm512_loadu_si512(ptr + 3), last);
+      const auto maskHigh = _mm512_mask_cmpeq_epi8_mask(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(ptr + 64), first), _mm512_loadu_si512(ptr + 67), last);
+
+      if(maskLow | maskHigh)
+      {
+        auto found = verifyMask(data, position, maskLow);
+        if(found == std::string::npos) found = verifyMask(data, position + 64, maskHigh);
+        if(found != std::string::npos) return found;
+      }
+
+      position += 128;
+    }
+
+    return findAVX2(data, size, position, limit);
+  }
+#endif
+}
+
+//----------------------------------------------------------------
+CaptureSearch::Kernel CaptureSearch::bestKernel()
+{
+#ifdef CAPTURE_SEARCH_X86
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx512bw")) return Kernel::AVX512;
+  if(__builtin_cpu_supports("avx2"))     return Kernel::AVX2;
+  if(__builtin_cpu_supports("sse2"))     return Kernel::SSE2;
+#endif
+
+  return Kernel::SCALAR;
+}
+
+//----------------------------------------------------------------
+CaptureSearch::Function CaptureSearch::kernelFunction(const Kernel kernel)
+{
+#ifdef CAPTURE_SEARCH_X86
+  __builtin_cpu_init();
+  switch(kernel)
+  {
+    case Kernel::AVX512:
+      return __builtin_cpu_supports("avx512bw") ? findAVX512 : nullptr;
+    case Kernel::AVX2:
+      return __builtin_cpu_supports("avx2") ? findAVX2 : nullptr;
+    case Kernel::SSE2:
+      return __builtin_cpu_supports("sse2") ? findSSE2 : nullptr;
+    default:
+      break;
+  }
+#else
+  if(kernel != Kernel::SCALAR) return nullptr;
+#endif
+
+  return findScalar;
+}
+
+//----------------------------------------------------------------
+const char *CaptureSearch::kernelName(const Kernel kernel)
+{
+  switch(kernel)
+  {
+    case Kernel::AVX512: return "AVX-512";
+    case Kernel::AVX2:   return "AVX2";
+    case Kernel::SSE2:   return "SSE2";
+    default:             break;
+  }
+
+  return "Scalar";
+}
+
+//----------------------------------------------------------------
+size_t CaptureSearch::find(const unsigned char *data, size_t size, size_t position, size_t limit)
+{
+  static const auto function = kernelFunction(bestKernel());
+
+  return function(data, size, position, limit);
+}
@@ -0,0 +1,77 @@
+/*
+ File: CaptureSearch.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CAPTURESEARCH_H_
+#define CAPTURESEARCH_H_
+
+// C++
+#include <cstddef>
+
+/** \brief Search of the Ogg page capture pattern, the "OggS" signature followed by
+ *         the stream structure version 0. The search is done with the widest vector
+ *         instructions supported by the CPU, selected at runtime.
+ *
+ */
+namespace CaptureSearch
+{
+  /** \brief Available search kernels.
+   *
+   */
+  enum class Kernel: char { SCALAR = 0, SSE2, AVX2, AVX512 };
+
+  /** \brief Search kernel signature. Returns the first position p in [position, limit)
+   *         where the data matches the capture pattern, or limit if there is none. A
+   *         position closer than 5 bytes to the end of the data is returned if the
+   *         remaining bytes match the beginning of the pattern.
+   * \param[in] data Data pointer.
+   * \param[in] size Data size in bytes.
+   * \param[in] position Initial search position.
+   * \param[in] limit Search positions lower than limit, must be lower or equal than size.
+   *
+   */
+  using Function = size_t (*)(const unsigned char *data, size_t size, size_t position, size_t limit);
+
+  /** \brief Returns the fastest kernel supported by the CPU.
+   *
+   */
+  Kernel bestKernel();
+
+  /** \brief Returns the function of the given kernel or nullptr if the CPU doesn't support it.
+   * \param[in] kernel Search kernel.
+   *
+   */
+  Function kernelFunction(const Kernel kernel);
+
+  /** \brief Returns the name of the given kernel.
+   * \param[in] kernel Search kernel.
+   *
+   */
+  const char *kernelName(const Kernel kernel);
+
+  /** \brief Searches the capture pattern using the fastest kernel. See Function.
+   * \param[in] data Data pointer.
+   * \param[in] size Data size in bytes.
+   * \param[in] position Initial search position.
+   * \param[in] limit Search positions lower than limit, must be lower or equal than size.
+   *
+   */
+  size_t find(const unsigned char *data, size_t size, size_t position, size_t limit);
+}
+
+#endif // CAPTURESEARCH_H_
@@ -0,0 +1,348 @@
+/*
+ File: ContainerScanner.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <CacheHints.h>
+#include <ContainerScanner.h>
+#include <ScanCheckpoint.h>
+
+// C++
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+const unsigned long long   CHUNK_SIZE          = 67108864;                /** 64 MB chunks when scanning in parallel. */
+const std::chrono::seconds CHECKPOINT_INTERVAL = std::chrono::seconds(30); /** time between checkpoints of a scan.      */
+
+//----------------------------------------------------------------
+ContainerScanner::ContainerScanner(const std::wstring &container)
+: m_container  {container}
+, m_size       {0}
+, m_threads    {1}
+, m_readMode   {ReadMode::ASYNC}
+, m_pageWalking{true}
+, m_checksum   {false}
+, m_cacheWindow{0}
+, m_checkpoints{false}
+, m_resume     {false}
+, m_resumed    {0}
+, m_aborted    {false}
+{
+  std::error_code error;
+  const auto size = std::filesystem::file_size(std::filesystem::path(m_container), error);
+  if(!error) m_size = size;
+}
+
+//----------------------------------------------------------------
+bool ContainerScanner::scan(StreamCallback callback, ProgressCallback progress)
+{
+  m_aborted = false;
+  m_error.clear();
+  m_resumed = 0;
+
+  ScanCheckpoint checkpoint(m_container);
+  checkpoint.setSettings(m_pageWalking, m_checksum);
+
+  OGGScanner::State state;
+  if(m_resume && checkpoint.load())
+  {
+    // the streams found before the checkpoint are given again.
+    for(const auto &stream: checkpoint.streams())
+    {
+      if(callback) callback(stream.first, stream.second);
+    }
+
+    state     = checkpoint.state();
+    m_resumed = state.position;
+  }
+
+  auto onStream = callback;
+  if(m_checkpoints)
+  {
+    onStream = [&checkpoint, &callback](unsigned long long start, unsigned long long end)
+    {
+      checkpoint.addStream(start, end);
+      if(callback) callback(start, end);
+    };
+  }
+
+  auto stored = m_checkpoints ? &checkpoint : nullptr;
+
+  bool result = false;
+  if(m_threads > 1 && m_size - state.position >= 2 * CHUNK_SIZE)
+    result = scanParallel(onStream, progress, state, stored);
+  else
+    result = scanSequential(onStream, progress, state, stored);
+
+  if(result && m_checkpoints) checkpoint.remove();
+
+  return result;
+}
+
+//----------------------------------------------------------------
+ReadMode ContainerScanner::readMode() const
+{
+  if(m_cacheWindow > 0 && m_readMode == ReadMode::MAPPED) return ReadMode::ASYNC;
+
+  return m_readMode;
+}
+
+//----------------------------------------------------------------
+bool ContainerScanner::scanSequential(StreamCallback callback, ProgressCallback progress, const OGGScanner::State &state,
+                                      ScanCheckpoint *checkpoint)
+{
+  auto reader = BlockReader::create(m_container, readMode());
+  OGGScanner scanner(callback);
+  scanner.setPageWalking(m_pageWalking);
+  scanner.setChecksumValidation(m_checksum);
+  scanner.restore(state);
+  unsigned long long processed = state.position;
+  auto saved = std::chrono::steady_clock::now();
+
+  auto store = [&scanner, checkpoint]()
+  {
+    checkpoint->setState(scanner.state());
+    checkpoint->save();
+  };
+
+  auto onBlock = [this, &processed, &progress, &saved, &store, checkpoint](unsigned long long bytes)
+  {
+    processed += bytes;
+    if(progress && !progress(processed)) m_aborted = true;
+
+    if(checkpoint && std::chrono::steady_clock::now() - saved >= CHECKPOINT_INTERVAL)
+    {
+      store();
+      saved = std::chrono::steady_clock::now();
+    }
+
+    return !m_aborted;
+  };
+
+  const auto result = scanRange(*reader, state.position, m_size, scanner, m_cacheWindow, onBlock, m_error);
+
+  // the state is the one after the last scanned block, also on error.
+  if(!result && checkpoint) store();
+
+  return result;
+}
+
+//----------------------------------------------------------------
+bool ContainerScanner::scanParallel(StreamCallback callback, ProgressCallback progress, const OGGScanner::State &state,
+                                    ScanCheckpoint *checkpoint)
+{
+  const auto start = state.position;
+  const unsigned long long chunksNum = (m_size - start + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+  std::vector<std::vector<OGGPage>> chunkPages(chunksNum);
+  std::vector<unsigned long long>   chunkResume(chunksNum, 0);
+  std::vector<char>                 chunkDone(chunksNum, false);
+  std::atomic<unsigned long long>   nextChunk{0};
+  std::atomic<unsigned long long>   processed{start};
+  std::atomic<bool>                 failed{false};
+  std::mutex                        mutex;
+  std::condition_variable           condition;
+
+  auto fail = [this, &mutex, &failed, &condition](const std::string &message)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if(!failed && m_error.empty()) m_error = message;
+      failed = true;
+    }
+    condition.notify_all();
+  };
+
+  const auto threadsNum = std::min<unsigned long long>(m_threads, chunksNum);
+
+  // the cache window is shared by the threads.
+  const auto cacheWindow = m_cacheWindow / threadsNum;
+
+  auto worker = [&]()
+  {
+    auto reader = BlockReader::create(m_container, readMode());
+
+    auto onBlock = [this, &processed, &failed](unsigned long long bytes)
+    {
+      processed += bytes;
+      return !m_aborted && !failed;
+    };
+
+    while(!m_aborted && !failed)
+    {
+      const auto chunk = nextChunk++;
+      if(chunk >= chunksNum) break;
+
+      const auto begin = start + chunk * CHUNK_SIZE;
+      const auto end   = std::min(begin + CHUNK_SIZE, m_size);
+
+      std::vector<OGGPage> pages;
+      OGGScanner scanner(nullptr, begin, end);
+      scanner.setPageWalking(m_pageWalking);
+      scanner.setChecksumValidation(m_checksum);
+
+      if(chunk == 0)
+      {
+        // continue walking the pages of the resumed scan, the merger has the open streams.
+        OGGScanner::State chunkState;
+        chunkState.position = begin;
+        chunkState.walking  = state.walking;
+        scanner.restore(chunkState);
+      }
+      scanner.setPageCallback([&pages](const OGGPage &page) { pages.push_back(page); });
+
+      std::string error;
+      if(!scanRange(*reader, begin, end, scanner, cacheWindow, onBlock, error))
+      {
+        if(!error.empty()) fail(error);
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        chunkPages[chunk]  = std::move(pages);
+        chunkResume[chunk] = scanner.resumePosition();
+        chunkDone[chunk]   = true;
+      }
+      condition.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for(unsigned int i = 0; i < threadsNum; ++i)
+    threads.emplace_back(worker);
+
+  // merge the pages of the chunks in order, as a sequential scan would find them. The pages
+  // of a chunk before the resume position of the previous one are inside walked pages.
+  OGGScanner merger(callback);
+  merger.restore(state);
+  unsigned long long merged = 0;
+  unsigned long long resume = start;
+  unsigned long long released = start;
+  bool walking = state.walking;
+  auto saved = std::chrono::steady_clock::now();
+
+  // the merged chunks are a sequential scan until the resume position of the last one.
+  auto store = [&merger, &resume, &walking, checkpoint]()
+  {
+    auto mergedState     = merger.state();
+    mergedState.position = resume;
+    mergedState.walking  = walking;
+
+    checkpoint->setState(mergedState);
+    checkpoint->save();
+  };
+  while(merged < chunksNum && !m_aborted && !failed)
+  {
+    std::vector<OGGPage> pages;
+    bool done = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait_for(lock, std::chrono::milliseconds(100), [&]() { return chunkDone[merged] || failed; });
+
+      done = chunkDone[merged];
+      if(done) pages = std::move(chunkPages[merged]);
+    }
+
+    if(done)
+    {
+      for(const auto &page: pages)
+      {
+        if(page.offset < resume) continue;
+
+        merger.addPage(page);
+
+        // the callback may read the streams again after the threads released the chunks.
+        if(m_cacheWindow > 0 && page.offset >= released + m_cacheWindow / 4)
+        {
+          CacheHints::drop(m_container, released, page.offset);
+          released = page.offset;
+        }
+      }
+
+      resume = chunkResume[merged];
+
+      // the limit of the chunk was crossed while walking pages if the resume position is after it.
+      walking = resume != std::min(start + (merged + 1) * CHUNK_SIZE, m_size);
+
+      ++merged;
+
+      if(checkpoint && std::chrono::steady_clock::now() - saved >= CHECKPOINT_INTERVAL)
+      {
+        store();
+        saved = std::chrono::steady_clock::now();
+      }
+    }
+
+    if(progress && !progress(processed)) m_aborted = true;
+  }
+
+  for(auto &thread: threads)
+    thread.join();
+
+  if(m_cacheWindow > 0) CacheHints::drop(m_container);
+
+  if(checkpoint && (m_aborted || failed)) store();
+
+  return !m_aborted && !failed;
+}
+
+//----------------------------------------------------------------
+bool ContainerScanner::scanRange(BlockReader &reader, unsigned long long begin, unsigned long long end, OGGScanner &scanner,
+                                 const unsigned long long cacheWindow, BlockCallback onBlock, std::string &error) const
+{
+  const auto readEnd = std::min<unsigned long long>(end + scanner.lookahead(), m_size);
+  auto position = begin;
+
+  // direct reads don't use the cache but the pages read to get the information of the streams are released.
+  CacheHints hints(m_container, cacheWindow, m_readMode != ReadMode::DIRECT);
+  hints.setRange(begin, readEnd);
+
+  if(!reader.setRange(begin, readEnd))
+  {
+    error = reader.error();
+    return false;
+  }
+
+  const unsigned char *data = nullptr;
+  size_t size = 0;
+  while(reader.next(data, size))
+  {
+    scanner.scan(data, size);
+
+    const auto scanned = position < end ? std::min<unsigned long long>(size, end - position) : 0;
+    position += size;
+
+    hints.advance(position);
+
+    if(onBlock && !onBlock(scanned)) return false;
+  }
+
+  if(!reader.error().empty())
+  {
+    error = reader.error();
+    return false;
+  }
+
+  scanner.finish();
+
+  return true;
+}
@@ -0,0 +1,216 @@
+/*
+ File: ContainerScanner.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONTAINERSCANNER_H_
+#define CONTAINERSCANNER_H_
+
+// Project
+#include <BlockReader.h>
+#include <OGGScanner.h>
+
+class ScanCheckpoint;
+
+// C++
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+/** \class ContainerScanner
+ * \brief Scans a container file for OGG streams. The container can be split in chunks
+ *        scanned in parallel by several threads, the results are merged in the same
+ *        order a sequential scan finds them.
+ *
+ */
+class ContainerScanner
+{
+  public:
+    /** \brief Function called with the [start, end) range of every found stream.
+     *
+     */
+    using StreamCallback = OGGScanner::StreamCallback;
+
+    /** \brief Function called with the number of scanned bytes of the container. Returns
+     *         false to abort the scan.
+     *
+     */
+    using ProgressCallback = std::function<bool(unsigned long long processed)>;
+
+    /** \brief ContainerScanner class constructor.
+     * \param[in] container Container file name.
+     *
+     */
+    explicit ContainerScanner(const std::wstring &container);
+
+    /** \brief ContainerScanner class virtual destructor.
+     *
+     */
+    virtual ~ContainerScanner()
+    {}
+
+    /** \brief Sets the number of threads to scan the container.
+     * \param[in] threads Number of threads.
+     *
+     */
+    void setThreads(const unsigned int threads)
+    { m_threads = std::max(1U, threads); }
+
+    /** \brief Sets the way the container is read. The container is read asynchronously by default.
+     * \param[in] mode Read mode.
+     *
+     */
+    void setReadMode(const ReadMode mode)
+    { m_readMode = mode; }
+
+    /** \brief Enables or disables following the chain of pages of the streams instead of
+     *         scanning every byte. Enabled by default.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setPageWalking(const bool value)
+    { m_pageWalking = value; }
+
+    /** \brief Enables or disables the verification of the checksum of the pages. Disabled by default.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setChecksumValidation(const bool value)
+    { m_checksum = value; }
+
+    /** \brief Sets the maximum size of the container in the system cache while scanning. The
+     *         pages are requested ahead of the scan and released once scanned. Mapped reads use
+     *         the asynchronous reader instead, as the pages of a mapping can't be released.
+     *         Disabled by default.
+     * \param[in] bytes Window size in bytes, 0 to disable.
+     *
+     */
+    void setCacheWindow(const unsigned long long bytes)
+    { m_cacheWindow = bytes; }
+
+    /** \brief Enables or disables storing the progress of the scan periodically and when the scan
+     *         fails or is aborted, so it can be resumed later. Disabled by default.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setCheckpoints(const bool value)
+    { m_checkpoints = value; }
+
+    /** \brief Enables or disables continuing the scan from the stored progress of the container, if
+     *         any. The streams found before are given again to the stream callback. Disabled by default.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setResume(const bool value)
+    { m_resume = value; }
+
+    /** \brief Scans the container and returns true on success and false on error or if aborted.
+     *         The stream callback and the progress callback are called from the calling thread.
+     * \param[in] callback Function to call for every found stream.
+     * \param[in] progress Function to call with the progress of the scan.
+     *
+     */
+    bool scan(StreamCallback callback, ProgressCallback progress = nullptr);
+
+    /** \brief Returns true if the scan was aborted by the progress callback.
+     *
+     */
+    bool isAborted() const
+    { return m_aborted; }
+
+    /** \brief Returns the error message of the last scan or an empty string if there was no error.
+     *
+     */
+    const std::string &error() const
+    { return m_error; }
+
+    /** \brief Returns the size of the container in bytes.
+     *
+     */
+    unsigned long long size() const
+    { return m_size; }
+
+    /** \brief Returns the position where the last scan continued a previous one, or 0 if it began
+     *         from the start of the container.
+     *
+     */
+    unsigned long long resumedPosition() const
+    { return m_resumed; }
+
+  private:
+    /** \brief Function called with the number of bytes scanned of a block. Returns false to stop.
+     *
+     */
+    using BlockCallback = std::function<bool(unsigned long long bytes)>;
+
+    /** \brief Returns the read mode used to scan, which depends on the cache window.
+     *
+     */
+    ReadMode readMode() const;
+
+    /** \brief Scans the container in the calling thread.
+     * \param[in] callback Function to call for every found stream.
+     * \param[in] progress Function to call with the progress of the scan.
+     * \param[in] state State to continue the scan from.
+     * \param[in] checkpoint Checkpoint to store the progress or nullptr to not store it.
+     *
+     */
+    bool scanSequential(StreamCallback callback, ProgressCallback progress, const OGGScanner::State &state,
+                        ScanCheckpoint *checkpoint);
+
+    /** \brief Scans the container in chunks using several threads.
+     * \param[in] callback Function to call for every found stream.
+     * \param[in] progress Function to call with the progress of the scan.
+     * \param[in] state State to continue the scan from.
+     * \param[in] checkpoint Checkpoint to store the progress or nullptr to not store it.
+     *
+     */
+    bool scanParallel(StreamCallback callback, ProgressCallback progress, const OGGScanner::State &state,
+                      ScanCheckpoint *checkpoint);
+
+    /** \brief Scans the pages of the container in the range [begin, end), reading after the end
+     *         of the range the bytes needed to parse the last pages. Returns
+     *         false on I/O error or if the block callback returns false.
+     * \param[in] reader Container reader.
+     * \param[in] begin Range beginning position.
+     * \param[in] end Range ending position.
+     * \param[in] scanner Scanner for the range.
+     * \param[in] cacheWindow Maximum size of the range in the system cache, 0 for no limit.
+     * \param[in] onBlock Function to call after scanning every block.
+     * \param[out] error Error message on I/O error.
+     *
+     */
+    bool scanRange(BlockReader &reader, unsigned long long begin, unsigned long long end, OGGScanner &scanner,
+                   const unsigned long long cacheWindow, BlockCallback onBlock, std::string &error) const;
+
+    const std::wstring m_container;   /** container file name.                      */
+    unsigned long long m_size;        /** container size in bytes.                  */
+    unsigned int       m_threads;     /** number of threads to scan the container.  */
+    ReadMode           m_readMode;    /** container read mode.                      */
+    bool               m_pageWalking; /** true to follow the chain of pages.        */
+    bool               m_checksum;    /** true to verify the checksum of the pages. */
+    unsigned long long m_cacheWindow; /** system cache window, 0 for no limit.      */
+    bool               m_checkpoints; /** true to store the progress of the scans.  */
+    bool               m_resume;      /** true to continue the stored scan.         */
+    unsigned long long m_resumed;     /** position where the last scan continued.   */
+    std::atomic<bool>  m_aborted;     /** true if the scan was aborted.             */
+    std::string        m_error;       /** error message of the last scan.           */
+};
+
+#endif // CONTAINERSCANNER_H_
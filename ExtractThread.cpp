@@ -0,0 +1,216 @@
+/*
+ File: ExtractThread.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <CacheHints.h>
+#include <ExtractThread.h>
+#include <TarArchive.h>
+
+// Qt
+#include <QFile>
+
+// C++
+#include <algorithm>
+
+namespace
+{
+  const unsigned long long EXTRACT_BUDGET = 268435456; /** maximum size of the streams extracted at the same time. */
+}
+
+//--------------------------------------------------------------------
+ExtractThread::ExtractThread(const std::vector<OGGData> &streams, const QStringList &filenames, QObject *parent)
+: QThread       {parent}
+, m_streams     {streams}
+, m_filenames   {filenames}
+, m_aborted     {false}
+, m_releaseCache{false}
+, m_sequential  {false}
+, m_threads     {1}
+, m_durability  {FileCopy::Durability::NONE}
+, m_extracted   {0}
+{
+}
+
+//--------------------------------------------------------------------
+void ExtractThread::abort()
+{
+  m_aborted = true;
+}
+
+//--------------------------------------------------------------------
+void ExtractThread::onExtracted(const size_t index, const std::string &message)
+{
+  const auto &data = m_streams.at(index);
+  const auto filename = m_filenames.at(index).toStdWString();
+
+  if(message.empty())
+  {
+    ++m_extracted;
+
+    if(m_releaseCache)
+    {
+      CacheHints::drop(data.container, data.start, data.end);
+      if(m_archive.isEmpty()) CacheHints::dropWritten(filename);
+    }
+  }
+  else if(!m_aborted)
+  {
+    auto text    = tr("Couldn't extract file '%1'").arg(m_filenames.at(index));
+    auto details = tr("Error: %1").arg(QString::fromStdString(message));
+    emit error(text, details);
+  }
+}
+
+//--------------------------------------------------------------------
+void ExtractThread::writeArchive(FileCopy::ProgressCallback progress)
+{
+  const auto count = std::min<size_t>(m_streams.size(), m_filenames.size());
+
+  std::vector<TarArchive::Member> members;
+  for(size_t i = 0; i < count; ++i)
+  {
+    const auto &data = m_streams.at(i);
+    members.push_back(TarArchive::Member{m_filenames.at(i).toStdString(), data.container, data.start, data.end});
+  }
+
+  auto onFinished = [this](size_t i, const std::string &message) { onExtracted(i, message); };
+
+  std::string message;
+  if(!TarArchive::write(m_archive.toStdWString(), members, message, onFinished, progress, m_durability != FileCopy::Durability::NONE))
+  {
+    m_extracted = 0;
+
+    if(!m_aborted)
+    {
+      auto text    = tr("Couldn't write archive '%1'").arg(m_archive);
+      auto details = tr("Error: %1").arg(QString::fromStdString(message));
+      emit error(text, details);
+    }
+
+    return;
+  }
+
+  // the archive is complete but maybe not on the disk yet.
+  if(!message.empty())
+  {
+    auto text    = tr("Couldn't flush archive '%1' to the disk.").arg(m_archive);
+    auto details = tr("Error: %1").arg(QString::fromStdString(message));
+    emit error(text, details);
+  }
+
+  if(m_releaseCache) CacheHints::dropWritten(m_archive.toStdWString());
+}
+
+//--------------------------------------------------------------------
+void ExtractThread::run()
+{
+  const auto count = std::min<size_t>(m_streams.size(), m_filenames.size());
+
+  unsigned long long totalSize = 0;
+  for(size_t i = 0; i < count; ++i)
+    totalSize += m_streams.at(i).end - m_streams.at(i).start;
+
+  unsigned long long processed = 0;
+  int progressValue = 0;
+
+  auto updateProgress = [this, &totalSize, &processed, &progressValue](unsigned long long copied)
+  {
+    const int value = totalSize > 0 ? (100.0*static_cast<double>(processed + copied)/totalSize) : 100;
+    if(value != progressValue)
+    {
+      progressValue = value;
+      emit progress(value);
+    }
+
+    return !m_aborted;
+  };
+
+  if(!m_archive.isEmpty())
+  {
+    writeArchive(updateProgress);
+    emit progress(100);
+    return;
+  }
+
+  std::vector<std::wstring> containers;
+  for(size_t i = 0; i < count; ++i)
+  {
+    if(std::find(containers.cbegin(), containers.cend(), m_streams.at(i).container) == containers.cend())
+      containers.push_back(m_streams.at(i).container);
+  }
+
+  for(const auto &container: containers)
+  {
+    if(m_aborted) break;
+
+    std::vector<FileCopy::Range> ranges;
+    std::vector<size_t> indexes;
+    for(size_t i = 0; i < count; ++i)
+    {
+      const auto &data = m_streams.at(i);
+      if(data.container != container) continue;
+
+      ranges.push_back(FileCopy::Range{data.start, data.end, m_filenames.at(i).toStdWString()});
+      indexes.push_back(i);
+    }
+
+    auto onFinished = [this, &indexes](size_t i, const std::string &message) { onExtracted(indexes.at(i), message); };
+
+    // the streams of the container are extracted in one forward pass or several at the same time,
+    // the errors of every stream are reported without stopping the others.
+    const auto flush = (m_durability == FileCopy::Durability::FILE);
+
+    std::string message;
+    bool copied = false;
+    if(m_sequential)
+      copied = FileCopy::copyRanges(container, ranges, message, onFinished, updateProgress, flush);
+    else
+      copied = FileCopy::copyParallel(container, ranges, m_threads, EXTRACT_BUDGET, message, onFinished, updateProgress, flush);
+
+    if(!copied && !m_aborted && !message.empty())
+    {
+      auto text    = tr("Couldn't extract the files of '%1'").arg(QString::fromStdWString(container));
+      auto details = tr("Error: %1").arg(QString::fromStdString(message));
+      emit error(text, details);
+    }
+
+    for(const auto &range: ranges)
+      processed += range.end - range.begin;
+  }
+
+  // one flush for all the files, they are in the same file system.
+  if(m_durability == FileCopy::Durability::GROUP && m_extracted > 0)
+  {
+    for(const auto &filename: m_filenames)
+    {
+      if(!QFile::exists(filename)) continue;
+
+      std::string message;
+      if(!FileCopy::flushFileSystem(filename.toStdWString(), message))
+      {
+        auto text    = tr("Couldn't flush the extracted files to the disk.");
+        auto details = tr("Error: %1").arg(QString::fromStdString(message));
+        emit error(text, details);
+      }
+      break;
+    }
+  }
+
+  emit progress(100);
+}
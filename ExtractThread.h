@@ -0,0 +1,145 @@
+/*
+ File: ExtractThread.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EXTRACTTHREAD_H_
+#define EXTRACTTHREAD_H_
+
+// Project
+#include <FileCopy.h>
+#include <OGGContainerWrapper.h>
+
+// Qt
+#include <QStringList>
+#include <QThread>
+
+// C++
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+/** \class ExtractThread
+ * \brief Thread for extracting streams to files. The data is copied in parts of bounded
+ *        size, reporting the progress in bytes and stopping as soon as it's cancelled.
+ *
+ */
+class ExtractThread
+: public QThread
+{
+    Q_OBJECT
+  public:
+    /** \brief ExtractThread class constructor.
+     * \param[in] streams Streams to extract.
+     * \param[in] filenames Output file name of every stream.
+     * \param[in] parent Raw pointer of the QObject parent of this one.
+     *
+     */
+    explicit ExtractThread(const std::vector<OGGData> &streams, const QStringList &filenames, QObject *parent = nullptr);
+
+    /** \brief ExtractThread class virtual destructor.
+     *
+     */
+    virtual ~ExtractThread()
+    {}
+
+    /** \brief Cancels the extraction process, the file being written is removed.
+     *
+     */
+    void abort();
+
+    /** \brief Returns true if aborted and false otherwise.
+     *
+     */
+    const bool isAborted() const
+    { return m_aborted; }
+
+    /** \brief Returns the number of extracted streams.
+     *
+     */
+    const int extractedNumber() const
+    { return m_extracted; }
+
+    /** \brief Enables or disables releasing the extracted data from the system cache.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setReleaseCache(const bool value)
+    { m_releaseCache = value; }
+
+    /** \brief Enables or disables extracting the streams of each container in one sequential pass.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setSequential(const bool value)
+    { m_sequential = value; }
+
+    /** \brief Sets the maximum number of streams extracted at the same time, when not sequential.
+     * \param[in] value Number of streams.
+     *
+     */
+    void setThreads(const unsigned int value)
+    { m_threads = std::max(1U, value); }
+
+    /** \brief Sets the tar archive where the streams are written, the file names are the names of
+     *         the members in that case. Empty to write every stream to its file.
+     * \param[in] archive Archive file name.
+     *
+     */
+    void setArchive(const QString &archive)
+    { m_archive = archive; }
+
+    /** \brief Sets when the extracted data is flushed to the disk.
+     * \param[in] durability Flush policy.
+     *
+     */
+    void setDurability(const FileCopy::Durability durability)
+    { m_durability = durability; }
+
+  signals:
+    void progress(int);
+    void error(const QString, const QString);
+
+  protected:
+      virtual void run();
+
+  private:
+      /** \brief Writes the streams to the tar archive.
+       * \param[in] progress Progress callback.
+       *
+       */
+      void writeArchive(FileCopy::ProgressCallback progress);
+
+      /** \brief Called when the extraction of the given stream ends.
+       * \param[in] index Index of the stream.
+       * \param[in] message Error message, empty on success.
+       *
+       */
+      void onExtracted(const size_t index, const std::string &message);
+
+      const std::vector<OGGData> m_streams;      /** streams to extract.                               */
+      const QStringList          m_filenames;    /** output file names.                                */
+      std::atomic<bool>          m_aborted;      /** true if aborted, false otherwise.                 */
+      bool                       m_releaseCache; /** true to release the data from the cache.          */
+      bool                       m_sequential;   /** true to read each container only once.            */
+      unsigned int               m_threads;      /** number of streams extracted at the same time.     */
+      QString                    m_archive;      /** tar archive file name or empty to write files.    */
+      FileCopy::Durability       m_durability;   /** when the extracted data is flushed to the disk.   */
+      std::atomic<int>           m_extracted;    /** number of extracted streams.                      */
+};
+
+#endif // EXTRACTTHREAD_H_
@@ -0,0 +1,646 @@
+/*
+ File: FileCopy.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <FileCopy.h>
+#include <FileHandle.h>
+
+// C++
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#endif
+
+namespace
+{
+  const size_t COPY_BUFFER_SIZE = 1048576; /** buffer size of the buffered copy.                          */
+  const size_t COPY_CHUNK_SIZE  = 8388608; /** maximum size copied by the kernel between progress calls. */
+
+#ifndef _WIN32
+  //----------------------------------------------------------------
+  std::string systemError(const std::string &message)
+  {
+    return message + " " + std::strerror(errno);
+  }
+#endif
+
+#ifdef __linux__
+  /** \brief Reserves the space of the given size for the file without changing its size.
+   * \param[in] descriptor File descriptor.
+   * \param[in] size Size to reserve.
+   *
+   */
+  void reserve(int descriptor, unsigned long long size)
+  {
+    // not all file systems allow it, the data is written anyway.
+    if(size > 0) fallocate(descriptor, FALLOC_FL_KEEP_SIZE, 0, size);
+  }
+
+  //----------------------------------------------------------------
+  bool isUnsupported(const int error)
+  {
+    return error == ENOSYS || error == EXDEV || error == EINVAL || error == EOPNOTSUPP || error == ENOTTY ||
+           error == EBADF  || error == EPERM;
+  }
+
+  /** \brief Shares the extents of the aligned part of the range with the destination and returns the
+   *         number of bytes cloned, 0 if it can't be done.
+   * \param[in] input Source file descriptor.
+   * \param[in] output Destination file descriptor.
+   * \param[in] begin Start of the range in the source file.
+   * \param[in] size Size of the range.
+   *
+   */
+  unsigned long long cloneRange(int input, int output, unsigned long long begin, unsigned long long size)
+  {
+#ifdef FICLONERANGE
+    struct stat info;
+    if(fstat(input, &info) != 0 || info.st_blksize <= 0) return 0;
+
+    // the destination starts at 0, the source must start at a block boundary. The last block
+    // can be partial only at the end of the source.
+    const unsigned long long blockSize = info.st_blksize;
+    if(begin % blockSize != 0) return 0;
+
+    auto length = size - (size % blockSize);
+    if(begin + size == static_cast<unsigned long long>(info.st_size)) length = size;
+    if(length == 0) return 0;
+
+    struct file_clone_range range;
+    range.src_fd      = input;
+    range.src_offset  = begin;
+    range.src_length  = length;
+    range.dest_offset = 0;
+
+    if(ioctl(output, FICLONERANGE, &range) != 0) return 0;
+
+    return length;
+#else
+    return 0;
+#endif
+  }
+#endif
+}
+
+//----------------------------------------------------------------
+bool FileCopy::copyRange(const std::wstring &source, unsigned long long begin, unsigned long long end,
+                         const std::wstring &destination, std::string &error, Method *method,
+                         ProgressCallback progress, const bool flush)
+{
+  error.clear();
+  if(method) *method = Method::BUFFERED;
+
+  const auto size = end > begin ? end - begin : 0;
+  unsigned long long done = 0;
+  bool cancelled = false;
+
+  // the method that copied the first part of the data.
+  auto used = Method::BUFFERED;
+  bool copied = false;
+  auto advance = [&](const Method value, const unsigned long long bytes)
+  {
+    if(!copied) used = value;
+    copied = true;
+
+    done += bytes;
+    if(progress && !progress(done)) cancelled = true;
+
+    return !cancelled;
+  };
+
+#ifdef __linux__
+  const auto input = ::open(std::filesystem::path(source).c_str(), O_RDONLY);
+  if(input == -1)
+  {
+    error = systemError("Unable to open the source file.");
+    return false;
+  }
+
+  const auto output = ::open(std::filesystem::path(destination).c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0644);
+  if(output == -1)
+  {
+    error = systemError("Unable to create the destination file.");
+    ::close(input);
+    return false;
+  }
+
+  // sharing the extents doesn't copy data, it is done in one call.
+  const auto cloned = cloneRange(input, output, begin, size);
+  if(cloned > 0) advance(Method::CLONE, cloned);
+  else reserve(output, size);
+
+#ifdef __NR_copy_file_range
+  // the rest is copied inside the kernel, the file systems that support it share the extents too.
+  bool copyRange = !cancelled;
+  while(copyRange && done < size)
+  {
+    loff_t inputOffset  = begin + done;
+    loff_t outputOffset = done;
+    const auto count = static_cast<size_t>(std::min<unsigned long long>(size - done, COPY_CHUNK_SIZE));
+    const auto result = syscall(__NR_copy_file_range, input, &inputOffset, output, &outputOffset, count, 0);
+    if(result < 0 && errno == EINTR) continue;
+
+    if(result > 0)
+    {
+      copyRange = advance(Method::COPY_RANGE, result);
+    }
+    else
+    {
+      if(result < 0 && !isUnsupported(errno)) error = systemError("Error copying the data.");
+      copyRange = false;
+    }
+  }
+#endif
+
+  bool sendData = error.empty() && !cancelled;
+  while(sendData && done < size)
+  {
+    off_t inputOffset = begin + done;
+    if(lseek(output, done, SEEK_SET) == -1) break;
+
+    const auto count = static_cast<size_t>(std::min<unsigned long long>(size - done, COPY_CHUNK_SIZE));
+    const auto sent = sendfile(output, input, &inputOffset, count);
+    if(sent < 0 && errno == EINTR) continue;
+
+    if(sent > 0)
+    {
+      sendData = advance(Method::SENDFILE, sent);
+    }
+    else
+    {
+      if(sent < 0 && !isUnsupported(errno)) error = systemError("Error copying the data.");
+      sendData = false;
+    }
+  }
+
+  if(error.empty() && !cancelled && done < size)
+  {
+    std::vector<unsigned char> buffer(std::min<unsigned long long>(size - done, COPY_BUFFER_SIZE));
+    while(done < size && !cancelled)
+    {
+      const auto count = static_cast<size_t>(std::min<unsigned long long>(size - done, buffer.size()));
+      const auto bytesRead = ::pread(input, buffer.data(), count, begin + done);
+      if(bytesRead < 0 && errno == EINTR) continue;
+      if(bytesRead <= 0)
+      {
+        error = bytesRead == 0 ? std::string("Unexpected end of the source file.") : systemError("Error reading the source file.");
+        break;
+      }
+
+      ssize_t written = 0;
+      while(written < bytesRead)
+      {
+        const auto result = ::pwrite(output, buffer.data() + written, bytesRead - written, done + written);
+        if(result < 0 && errno == EINTR) continue;
+        if(result <= 0) break;
+        written += result;
+      }
+
+      if(written < bytesRead)
+      {
+        error = systemError("Error writing the destination file.");
+        break;
+      }
+
+      advance(Method::BUFFERED, bytesRead);
+    }
+  }
+
+  if(flush && error.empty() && !cancelled && ::fsync(output) != 0) error = systemError("Error flushing the destination file.");
+
+  ::close(input);
+  if(::close(output) != 0 && error.empty()) error = systemError("Error closing the destination file.");
+#else
+  auto input = FileHandle::open(source);
+  if(!input)
+  {
+    error = "Unable to open the source file.";
+    return false;
+  }
+
+  std::ofstream output(std::filesystem::path(destination), std::ios_base::out|std::ios_base::binary|std::ios_base::trunc);
+  if(!output.is_open())
+  {
+    error = "Unable to create the destination file.";
+    return false;
+  }
+
+  preallocate(destination, size);
+
+  std::vector<unsigned char> buffer(std::min<unsigned long long>(size, COPY_BUFFER_SIZE));
+  while(done < size && !cancelled)
+  {
+    const auto count = static_cast<size_t>(std::min<unsigned long long>(size - done, buffer.size()));
+    const auto bytesRead = input->read(buffer.data(), count, begin + done);
+    if(bytesRead <= 0)
+    {
+      error = bytesRead == 0 ? "Unexpected end of the source file." : "Error reading the source file.";
+      break;
+    }
+
+    if(!output.write(reinterpret_cast<const char *>(buffer.data()), bytesRead))
+    {
+      error = "Error writing the destination file.";
+      break;
+    }
+
+    advance(Method::BUFFERED, bytesRead);
+  }
+
+  output.close();
+  if(output.fail() && error.empty()) error = "Error closing the destination file.";
+
+  if(flush && error.empty() && !cancelled) FileCopy::flush(destination, error);
+#endif
+
+  if(method) *method = used;
+
+  // the incomplete file is not useful.
+  if(cancelled)
+  {
+    std::error_code removeError;
+    std::filesystem::remove(std::filesystem::path(destination), removeError);
+    error = "Copy cancelled.";
+  }
+
+  return error.empty();
+}
+
+//----------------------------------------------------------------
+bool FileCopy::copyRanges(const std::wstring &source, const std::vector<Range> &ranges, std::string &error,
+                          RangeCallback finished, ProgressCallback progress, const bool flush)
+{
+  error.clear();
+
+  auto input = FileHandle::open(source);
+  if(!input)
+  {
+    error = "Unable to open the source file.";
+    return false;
+  }
+
+  std::vector<size_t> order(ranges.size());
+  for(size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&ranges](size_t a, size_t b) { return ranges[a].begin < ranges[b].begin; });
+
+  /** \struct Output
+   * \brief Destination file of a range being copied.
+   *
+   */
+  struct Output
+  {
+    size_t                         index; /** index of the range. */
+    std::unique_ptr<std::ofstream> file;  /** destination file.   */
+  };
+
+  bool failed = false;
+  std::vector<Output> active;
+  auto finish = [&ranges, &finished, &failed, &flush](Output &output, const std::string &message)
+  {
+    auto text = message;
+    if(output.file)
+    {
+      output.file->close();
+      if(output.file->fail() && text.empty()) text = "Error closing the destination file.";
+      output.file.reset();
+
+      if(flush && text.empty()) FileCopy::flush(ranges[output.index].destination, text);
+    }
+
+    // the incomplete file is not useful.
+    if(!text.empty())
+    {
+      std::error_code removeError;
+      std::filesystem::remove(std::filesystem::path(ranges[output.index].destination), removeError);
+      failed = true;
+    }
+
+    if(finished) finished(output.index, text);
+  };
+
+  std::vector<unsigned char> buffer;
+  unsigned long long position = 0;
+  unsigned long long done = 0;
+  size_t next = 0;
+  while(next < order.size() || !active.empty())
+  {
+    // the gaps between the ranges are skipped.
+    if(active.empty()) position = std::max(position, ranges[order[next]].begin);
+
+    while(next < order.size() && ranges[order[next]].begin <= position)
+    {
+      Output output{order[next++], nullptr};
+      const auto &range = ranges[output.index];
+
+      output.file = std::make_unique<std::ofstream>(std::filesystem::path(range.destination), std::ios_base::out|std::ios_base::binary|std::ios_base::trunc);
+      if(!output.file->is_open())
+      {
+        output.file.reset();
+        finish(output, "Unable to create the destination file.");
+        continue;
+      }
+
+      if(range.end <= range.begin)
+      {
+        finish(output, "");
+        continue;
+      }
+
+      preallocate(range.destination, range.end - range.begin);
+
+      active.push_back(std::move(output));
+    }
+
+    if(active.empty()) continue;
+
+    // every active range covers the whole part read, a new range begins only at its start.
+    auto partEnd = position + COPY_BUFFER_SIZE;
+    for(const auto &output: active)
+      partEnd = std::min(partEnd, ranges[output.index].end);
+    if(next < order.size()) partEnd = std::min(partEnd, ranges[order[next]].begin);
+
+    const auto count = static_cast<size_t>(partEnd - position);
+    if(buffer.size() < count) buffer.resize(count);
+
+    const auto bytesRead = input->read(buffer.data(), count, position);
+    if(bytesRead != static_cast<long long>(count))
+    {
+      const std::string message = bytesRead < 0 ? "Error reading the source file." : "Unexpected end of the source file.";
+      for(auto &output: active)
+        finish(output, message);
+
+      active.clear();
+      position = partEnd;
+      continue;
+    }
+
+    for(auto &output: active)
+    {
+      if(!output.file->write(reinterpret_cast<const char *>(buffer.data()), count))
+      {
+        finish(output, "Error writing the destination file.");
+        continue;
+      }
+
+      done += count;
+    }
+
+    position = partEnd;
+
+    auto ended = std::stable_partition(active.begin(), active.end(), [&ranges, &position](const Output &output)
+    {
+      return output.file && ranges[output.index].end > position;
+    });
+
+    for(auto it = ended; it != active.end(); ++it)
+      if(it->file) finish(*it, "");
+
+    active.erase(ended, active.end());
+
+    if(progress && !progress(done))
+    {
+      for(auto &output: active)
+        finish(output, "Copy cancelled.");
+
+      error = "Copy cancelled.";
+      return false;
+    }
+  }
+
+  return !failed;
+}
+
+//----------------------------------------------------------------
+bool FileCopy::copyParallel(const std::wstring &source, const std::vector<Range> &ranges, unsigned int threads,
+                            unsigned long long budget, std::string &error, RangeCallback finished,
+                            ProgressCallback progress, const bool flush)
+{
+  error.clear();
+
+  if(threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+  threads = static_cast<unsigned int>(std::min<size_t>(threads, ranges.size()));
+
+  std::mutex mutex;
+  std::condition_variable released;
+  unsigned long long inFlight = 0;
+  size_t next = 0;
+
+  std::mutex callbackMutex;
+  std::atomic<unsigned long long> done{0};
+  std::atomic<bool> cancelled{false};
+
+  // the ranges are taken in order, waiting for the budget before taking the next one.
+  auto worker = [&]()
+  {
+    while(true)
+    {
+      size_t index = 0;
+      unsigned long long size = 0;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        if(next >= ranges.size() || cancelled) return;
+
+        index = next;
+        const auto &range = ranges[index];
+        size = range.end > range.begin ? range.end - range.begin : 0;
+
+        released.wait(lock, [&]() { return cancelled || next != index || inFlight == 0 || budget == 0 || inFlight + size <= budget; });
+        if(cancelled) return;
+
+        // taken by other thread while waiting.
+        if(next != index) continue;
+
+        ++next;
+        inFlight += size;
+      }
+
+      const auto &range = ranges[index];
+
+      unsigned long long copied = 0;
+      auto onProgress = [&](unsigned long long value)
+      {
+        done += value - copied;
+        copied = value;
+
+        if(progress)
+        {
+          std::lock_guard<std::mutex> lock(callbackMutex);
+          if(!cancelled && !progress(done)) cancelled = true;
+        }
+
+        return !cancelled;
+      };
+
+      std::string message;
+      copyRange(source, range.begin, range.end, range.destination, message, nullptr, onProgress, flush);
+
+      if(finished)
+      {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        finished(index, message);
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        inFlight -= size;
+      }
+      released.notify_all();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for(unsigned int i = 1; i < threads; ++i)
+    workers.emplace_back(worker);
+
+  if(threads > 0) worker();
+
+  for(auto &thread: workers)
+    thread.join();
+
+  if(cancelled) error = "Copy cancelled.";
+
+  return !cancelled;
+}
+
+//----------------------------------------------------------------
+void FileCopy::preallocate(const std::wstring &filename, unsigned long long size)
+{
+  if(size == 0) return;
+
+#if defined(__linux__)
+  const auto descriptor = ::open(std::filesystem::path(filename).c_str(), O_WRONLY);
+  if(descriptor == -1) return;
+
+  reserve(descriptor, size);
+  ::close(descriptor);
+#elif defined(_WIN32)
+  auto handle = CreateFileW(filename.c_str(), GENERIC_WRITE, FILE_SHARE_READ|FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(handle == INVALID_HANDLE_VALUE) return;
+
+  // the allocation is kept while the file is open by the writer.
+  FILE_ALLOCATION_INFO info;
+  info.AllocationSize.QuadPart = static_cast<LONGLONG>(size);
+  SetFileInformationByHandle(handle, FileAllocationInfo, &info, sizeof(info));
+
+  CloseHandle(handle);
+#endif
+}
+
+//----------------------------------------------------------------
+bool FileCopy::flush(const std::wstring &filename, std::string &error)
+{
+#ifdef _WIN32
+  auto handle = CreateFileW(filename.c_str(), GENERIC_WRITE, FILE_SHARE_READ|FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(handle == INVALID_HANDLE_VALUE)
+  {
+    error = "Unable to open the file to flush it.";
+    return false;
+  }
+
+  const auto flushed = FlushFileBuffers(handle);
+  CloseHandle(handle);
+
+  if(!flushed) error = "Error flushing the file.";
+
+  return flushed;
+#else
+  // the written pages belong to the file, not to the descriptor used to write them.
+  const auto descriptor = ::open(std::filesystem::path(filename).c_str(), O_WRONLY);
+  if(descriptor == -1)
+  {
+    error = systemError("Unable to open the file to flush it.");
+    return false;
+  }
+
+  const auto flushed = (::fsync(descriptor) == 0);
+  if(!flushed) error = systemError("Error flushing the file.");
+
+  ::close(descriptor);
+
+  return flushed;
+#endif
+}
+
+//----------------------------------------------------------------
+bool FileCopy::flushFileSystem(const std::wstring &filename, std::string &error)
+{
+#if defined(__linux__)
+  const auto descriptor = ::open(std::filesystem::path(filename).c_str(), O_RDONLY);
+  if(descriptor == -1)
+  {
+    error = systemError("Unable to open the file to flush its file system.");
+    return false;
+  }
+
+  const auto flushed = (::syncfs(descriptor) == 0);
+  if(!flushed) error = systemError("Error flushing the file system.");
+
+  ::close(descriptor);
+
+  return flushed;
+#elif defined(_WIN32)
+  // flushing a volume needs administrator rights.
+  return flush(filename, error);
+#else
+  ::sync();
+
+  return true;
+#endif
+}
+
+//----------------------------------------------------------------
+std::string FileCopy::name(const Method method)
+{
+  switch(method)
+  {
+    case Method::CLONE:
+      return "clone";
+    case Method::COPY_RANGE:
+      return "copy_file_range";
+    case Method::SENDFILE:
+      return "sendfile";
+    default:
+    case Method::BUFFERED:
+      break;
+  }
+
+  return "buffered";
+}
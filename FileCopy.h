@@ -0,0 +1,151 @@
+/*
+ File: FileCopy.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILECOPY_H_
+#define FILECOPY_H_
+
+// C++
+#include <functional>
+#include <string>
+#include <vector>
+
+/** \brief Copies ranges of a file to new files inside the kernel when the system allows it,
+ *         sharing the extents of the file system if the range is aligned, so the data doesn't
+ *         need to go through the memory of the process. The data is copied with a buffer as the
+ *         last option. Many ranges of the same file can be copied in one sequential pass.
+ *
+ */
+namespace FileCopy
+{
+  /** \brief Method used to copy the data.
+   *
+   */
+  enum class Method: char { CLONE, COPY_RANGE, SENDFILE, BUFFERED };
+
+  /** \brief When the copied data is flushed to the disk: never, once for the whole file system at the end
+   *         of the process with flushFileSystem() or every file before closing it.
+   *
+   */
+  enum class Durability: char { NONE, GROUP, FILE };
+
+  /** \brief Function called with the number of bytes copied after every part of the copy, returns
+   *         false to cancel it.
+   *
+   */
+  using ProgressCallback = std::function<bool(unsigned long long)>;
+
+  /** \brief Creates or truncates the destination file and copies the [begin, end) range of the source file
+   *         to it. Returns true on success and false otherwise.
+   * \param[in] source Source file name.
+   * \param[in] begin Start of the range in the source file.
+   * \param[in] end End of the range in the source file.
+   * \param[in] destination Destination file name.
+   * \param[out] error Error message if the copy fails.
+   * \param[out] method Method used to copy the data, the first one if several were needed, or nullptr if not needed.
+   * \param[in] progress Progress callback or nullptr. The destination file is removed if cancelled.
+   * \param[in] flush True to flush the destination file to the disk before closing it.
+   *
+   */
+  bool copyRange(const std::wstring &source, unsigned long long begin, unsigned long long end,
+                 const std::wstring &destination, std::string &error, Method *method = nullptr,
+                 ProgressCallback progress = nullptr, const bool flush = false);
+
+  /** \struct Range
+   * \brief Range of the source file copied to a destination file.
+   *
+   */
+  struct Range
+  {
+    unsigned long long begin;       /** start of the range in the source file. */
+    unsigned long long end;         /** end of the range in the source file.   */
+    std::wstring       destination; /** destination file name.                 */
+  };
+
+  /** \brief Function called when the copy of a range ends, with the index of the range and the
+   *         error message, empty on success.
+   *
+   */
+  using RangeCallback = std::function<void(size_t, const std::string &)>;
+
+  /** \brief Copies the given ranges of the source file to their destination files reading the
+   *         source only once and forward. The ranges can overlap, the gaps between them are not
+   *         read. Returns true if all the ranges could be copied and false otherwise.
+   * \param[in] source Source file name.
+   * \param[in] ranges Ranges to copy.
+   * \param[out] error Error message if the copy can't be done or is cancelled, the errors of the ranges are given to the callback.
+   * \param[in] finished Callback called when the copy of every range ends or nullptr.
+   * \param[in] progress Progress callback with the number of bytes written to the destinations or nullptr.
+   *                     The incomplete destination files are removed if cancelled.
+   * \param[in] flush True to flush every destination file to the disk before closing it.
+   *
+   */
+  bool copyRanges(const std::wstring &source, const std::vector<Range> &ranges, std::string &error,
+                  RangeCallback finished = nullptr, ProgressCallback progress = nullptr, const bool flush = false);
+
+  /** \brief Copies the given ranges of the source file to their destination files, several at the
+   *         same time. A range is not started while the sizes of the ranges being copied would go
+   *         over the budget, unless no other range is being copied. Returns false if cancelled.
+   * \param[in] source Source file name.
+   * \param[in] ranges Ranges to copy.
+   * \param[in] threads Maximum number of ranges copied at the same time, 0 to use one per core.
+   * \param[in] budget Maximum number of bytes of the ranges copied at the same time, 0 for no limit.
+   * \param[out] error Error message if the copy is cancelled, the errors of the ranges are given to the callback.
+   * \param[in] finished Callback called when the copy of every range ends or nullptr.
+   * \param[in] progress Progress callback with the number of bytes written to the destinations or nullptr.
+   *                     The incomplete destination files are removed if cancelled.
+   * \param[in] flush True to flush every destination file to the disk before closing it.
+   *
+   * The callbacks are called from the copying threads, one at a time.
+   *
+   */
+  bool copyParallel(const std::wstring &source, const std::vector<Range> &ranges, unsigned int threads,
+                    unsigned long long budget, std::string &error, RangeCallback finished = nullptr,
+                    ProgressCallback progress = nullptr, const bool flush = false);
+
+  /** \brief Reserves the space of the given size for the file without changing its size, so it can be
+   *         written in contiguous extents. Does nothing if the system doesn't allow it.
+   * \param[in] filename File name.
+   * \param[in] size Size to reserve.
+   *
+   */
+  void preallocate(const std::wstring &filename, unsigned long long size);
+
+  /** \brief Flushes the written data of the given file to the disk. Returns true on success.
+   * \param[in] filename File name.
+   * \param[out] error Error message if the flush fails.
+   *
+   */
+  bool flush(const std::wstring &filename, std::string &error);
+
+  /** \brief Flushes the written data of the whole file system of the given file to the disk, only the
+   *         data of the file if the system doesn't allow it. Returns true on success.
+   * \param[in] filename File name.
+   * \param[out] error Error message if the flush fails.
+   *
+   */
+  bool flushFileSystem(const std::wstring &filename, std::string &error);
+
+  /** \brief Returns the name of the given copy method.
+   * \param[in] method Copy method.
+   *
+   */
+  std::string name(const Method method);
+}
+
+#endif // FILECOPY_H_
@@ -0,0 +1,129 @@
+/*
+ File: FileHandle.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <FileHandle.h>
+
+// C++
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------
+std::shared_ptr<FileHandle> FileHandle::open(const std::wstring &filename)
+{
+  static std::mutex mutex;
+  static std::map<std::wstring, std::weak_ptr<FileHandle>> files;
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto file = files[filename].lock();
+  if(!file)
+  {
+    file = std::make_shared<FileHandle>(filename);
+    if(!file->isOpen())
+    {
+      files.erase(filename);
+      return nullptr;
+    }
+
+    files[filename] = file;
+  }
+
+  return file;
+}
+
+//----------------------------------------------------------------
+FileHandle::FileHandle(const std::wstring &filename)
+#ifdef _WIN32
+: m_handle    {INVALID_HANDLE_VALUE}
+#else
+: m_descriptor{-1}
+#endif
+{
+#ifdef _WIN32
+  m_handle = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+#else
+  m_descriptor = ::open(std::filesystem::path(filename).c_str(), O_RDONLY);
+#endif
+}
+
+//----------------------------------------------------------------
+FileHandle::~FileHandle()
+{
+#ifdef _WIN32
+  if(m_handle != INVALID_HANDLE_VALUE) CloseHandle(m_handle);
+#else
+  if(m_descriptor != -1) ::close(m_descriptor);
+#endif
+}
+
+//----------------------------------------------------------------
+bool FileHandle::isOpen() const
+{
+#ifdef _WIN32
+  return m_handle != INVALID_HANDLE_VALUE;
+#else
+  return m_descriptor != -1;
+#endif
+}
+
+//----------------------------------------------------------------
+long long FileHandle::read(unsigned char *buffer, size_t size, unsigned long long position) const
+{
+  if(!isOpen()) return -1;
+
+  size_t done = 0;
+  while(done < size)
+  {
+#ifdef _WIN32
+    OVERLAPPED overlapped;
+    std::memset(&overlapped, 0, sizeof(overlapped));
+    overlapped.Offset     = static_cast<DWORD>((position + done) & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>((position + done) >> 32);
+
+    DWORD bytesRead = 0;
+    const auto toRead = static_cast<DWORD>(std::min<size_t>(size - done, 0x40000000));
+    if(!ReadFile(m_handle, buffer + done, toRead, &bytesRead, &overlapped))
+      return GetLastError() == ERROR_HANDLE_EOF ? static_cast<long long>(done) : -1;
+#else
+    const auto bytesRead = ::pread(m_descriptor, buffer + done, size - done, position + done);
+    if(bytesRead < 0)
+    {
+      if(errno == EINTR) continue;
+      return -1;
+    }
+#endif
+
+    if(bytesRead == 0) break;
+    done += bytesRead;
+  }
+
+  return done;
+}
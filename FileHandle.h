@@ -0,0 +1,79 @@
+/*
+ File: FileHandle.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILEHANDLE_H_
+#define FILEHANDLE_H_
+
+// C++
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/** \class FileHandle
+ * \brief Read-only file handle with positional reads, that can be used from several threads
+ *        at the same time. The handles of the same file are shared.
+ *
+ */
+class FileHandle
+{
+  public:
+    /** \brief Returns the handle of the given file shared with the other users of the same file.
+     *         Returns nullptr if the file can't be opened.
+     * \param[in] filename File name.
+     *
+     */
+    static std::shared_ptr<FileHandle> open(const std::wstring &filename);
+
+    /** \brief FileHandle class constructor.
+     * \param[in] filename File name.
+     *
+     */
+    explicit FileHandle(const std::wstring &filename);
+
+    /** \brief FileHandle class virtual destructor.
+     *
+     */
+    virtual ~FileHandle();
+
+    /** \brief Returns true if the file has been opened.
+     *
+     */
+    bool isOpen() const;
+
+    /** \brief Reads up to size bytes at the given position and returns the number of bytes read,
+     *         less than size only at the end of the file, or -1 on error.
+     * \param[in] buffer Destination buffer.
+     * \param[in] size Number of bytes to read.
+     * \param[in] position Position in the file.
+     *
+     */
+    long long read(unsigned char *buffer, size_t size, unsigned long long position) const;
+
+    FileHandle(const FileHandle &) = delete;
+    FileHandle &operator=(const FileHandle &) = delete;
+
+  private:
+#ifdef _WIN32
+    void *m_handle;     /** file handle.     */
+#else
+    int   m_descriptor; /** file descriptor. */
+#endif
+};
+
+#endif // FILEHANDLE_H_
@@ -0,0 +1,204 @@
+/*
+ File: MappedFile.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <MappedFile.h>
+
+// C++
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const bool               IS_64_BITS     = sizeof(void *) >= 8;                     /** true on 64 bit systems.                   */
+const unsigned long long MAPPING_BUDGET = IS_64_BITS ? (1ULL << 36) : (1ULL << 28); /** files up to 64 GB (256 MB) mapped whole. */
+const size_t             WINDOW_SIZE    = IS_64_BITS ? (1ULL << 30) : (1ULL << 26); /** windows of 1 GB (64 MB) for bigger ones.  */
+
+namespace
+{
+  //----------------------------------------------------------------
+  unsigned long long mappingGranularity()
+  {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#else
+    return sysconf(_SC_PAGESIZE);
+#endif
+  }
+}
+
+//----------------------------------------------------------------
+MappedFile::Region::Region(void *base, size_t baseSize, const unsigned char *data, size_t size)
+: m_base    {base}
+, m_baseSize{baseSize}
+, m_data    {data}
+, m_size    {size}
+{
+}
+
+//----------------------------------------------------------------
+MappedFile::Region::~Region()
+{
+  if(!m_base) return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_base);
+#else
+  munmap(m_base, m_baseSize);
+#endif
+}
+
+//----------------------------------------------------------------
+void MappedFile::Region::adviseSequential() const
+{
+#ifndef _WIN32
+  // madvise needs a page aligned address.
+  static const auto pageSize = mappingGranularity();
+  const auto address = reinterpret_cast<uintptr_t>(m_data) & ~static_cast<uintptr_t>(pageSize - 1);
+  madvise(reinterpret_cast<void *>(address), m_size + (reinterpret_cast<uintptr_t>(m_data) - address), MADV_SEQUENTIAL);
+#endif
+}
+
+//----------------------------------------------------------------
+std::shared_ptr<MappedFile> MappedFile::open(const std::wstring &filename)
+{
+  static std::mutex mutex;
+  static std::map<std::wstring, std::weak_ptr<MappedFile>> files;
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto file = files[filename].lock();
+  if(!file)
+  {
+    file = std::make_shared<MappedFile>(filename);
+    if(!file->isOpen())
+    {
+      files.erase(filename);
+      return nullptr;
+    }
+
+    files[filename] = file;
+  }
+
+  return file;
+}
+
+//----------------------------------------------------------------
+size_t MappedFile::windowSize()
+{
+  return WINDOW_SIZE;
+}
+
+//----------------------------------------------------------------
+MappedFile::MappedFile(const std::wstring &filename)
+: m_size      {0}
+#ifdef _WIN32
+, m_file      {INVALID_HANDLE_VALUE}
+, m_mapping   {nullptr}
+#else
+, m_descriptor{-1}
+#endif
+{
+#ifdef _WIN32
+  m_file = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(m_file == INVALID_HANDLE_VALUE) return;
+
+  LARGE_INTEGER size;
+  if(!GetFileSizeEx(m_file, &size)) return;
+  m_size = size.QuadPart;
+
+  // files of size 0 can't be mapped.
+  if(m_size > 0) m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+#else
+  m_descriptor = ::open(std::filesystem::path(filename).c_str(), O_RDONLY);
+  if(m_descriptor == -1) return;
+
+  struct stat info;
+  if(0 != fstat(m_descriptor, &info)) return;
+  m_size = info.st_size;
+#endif
+
+  if(m_size > 0 && m_size <= MAPPING_BUDGET)
+  {
+    // the whole file region is used as the base of the rest, no need to map again.
+    m_full = map(0, m_size);
+  }
+}
+
+//----------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+  m_full = nullptr;
+
+#ifdef _WIN32
+  if(m_mapping) CloseHandle(m_mapping);
+  if(m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+#else
+  if(m_descriptor != -1) ::close(m_descriptor);
+#endif
+}
+
+//----------------------------------------------------------------
+bool MappedFile::isOpen() const
+{
+#ifdef _WIN32
+  return m_file != INVALID_HANDLE_VALUE && (m_mapping != nullptr || m_size == 0);
+#else
+  return m_descriptor != -1;
+#endif
+}
+
+//----------------------------------------------------------------
+std::shared_ptr<const MappedFile::Region> MappedFile::map(unsigned long long offset, size_t size) const
+{
+  if(!isOpen() || size == 0 || offset + size > m_size) return nullptr;
+
+  if(m_full)
+  {
+    // sub-region of the whole file mapping, keeps the mapping alive.
+    auto full = m_full;
+    return std::shared_ptr<const Region>(new Region(nullptr, 0, full->data() + offset, size), [full](const Region *region) { delete region; });
+  }
+
+  static const auto granularity = mappingGranularity();
+  const auto base     = offset - (offset % granularity);
+  const auto baseSize = static_cast<size_t>(size + (offset - base));
+
+#ifdef _WIN32
+  auto address = MapViewOfFile(m_mapping, FILE_MAP_READ, static_cast<DWORD>(base >> 32), static_cast<DWORD>(base & 0xFFFFFFFF), baseSize);
+  if(!address) return nullptr;
+#else
+  auto address = mmap(nullptr, baseSize, PROT_READ, MAP_SHARED, m_descriptor, base);
+  if(address == MAP_FAILED) return nullptr;
+#endif
+
+  auto data = reinterpret_cast<const unsigned char *>(address) + (offset - base);
+  return std::shared_ptr<const Region>(new Region(address, baseSize, data, size));
+}
@@ -0,0 +1,145 @@
+/*
+ File: MappedFile.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+// C++
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/** \class MappedFile
+ * \brief Read-only memory mapping of a file. Files that fit in the address space budget
+ *        are mapped once as a whole, bigger files are mapped in windows on demand.
+ *
+ */
+class MappedFile
+{
+  public:
+    /** \class Region
+     * \brief Mapped range of the file, the memory is valid while the region exists.
+     *
+     */
+    class Region
+    {
+      public:
+        /** \brief Region class destructor. Unmaps the memory if owned by the region.
+         *
+         */
+        ~Region();
+
+        /** \brief Returns the pointer to the data of the region.
+         *
+         */
+        const unsigned char *data() const
+        { return m_data; }
+
+        /** \brief Returns the size of the region in bytes.
+         *
+         */
+        size_t size() const
+        { return m_size; }
+
+        /** \brief Tells the system the region will be read sequentially.
+         *
+         */
+        void adviseSequential() const;
+
+      private:
+        friend class MappedFile;
+
+        /** \brief Region class constructor.
+         * \param[in] base Start of the mapping, nullptr if the memory is not owned by the region.
+         * \param[in] baseSize Size of the mapping.
+         * \param[in] data Pointer to the data of the region.
+         * \param[in] size Size of the region in bytes.
+         *
+         */
+        Region(void *base, size_t baseSize, const unsigned char *data, size_t size);
+
+        void                *m_base;     /** mapping start or nullptr if not owned. */
+        size_t               m_baseSize; /** mapping size.                          */
+        const unsigned char *m_data;     /** region data.                           */
+        size_t               m_size;     /** region size in bytes.                  */
+    };
+
+    /** \brief Returns the mapping of the given file shared with the other users of the same file.
+     *         Returns nullptr if the file can't be opened.
+     * \param[in] filename File name.
+     *
+     */
+    static std::shared_ptr<MappedFile> open(const std::wstring &filename);
+
+    /** \brief Returns the maximum size of a region when the file is mapped in windows.
+     *
+     */
+    static size_t windowSize();
+
+    /** \brief MappedFile class constructor.
+     * \param[in] filename File name.
+     *
+     */
+    explicit MappedFile(const std::wstring &filename);
+
+    /** \brief MappedFile class virtual destructor.
+     *
+     */
+    virtual ~MappedFile();
+
+    /** \brief Returns true if the file has been opened.
+     *
+     */
+    bool isOpen() const;
+
+    /** \brief Returns the size of the file in bytes.
+     *
+     */
+    unsigned long long size() const
+    { return m_size; }
+
+    /** \brief Returns true if the whole file is mapped and regions don't need a system call.
+     *
+     */
+    bool isFullyMapped() const
+    { return m_full != nullptr; }
+
+    /** \brief Returns the region [offset, offset + size) of the file or nullptr on error or
+     *         if the range is outside the file.
+     * \param[in] offset Region start position.
+     * \param[in] size Region size in bytes.
+     *
+     */
+    std::shared_ptr<const Region> map(unsigned long long offset, size_t size) const;
+
+  private:
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    unsigned long long             m_size;       /** file size in bytes.                   */
+    std::shared_ptr<const Region>  m_full;       /** whole file mapping, if any.           */
+#ifdef _WIN32
+    void                          *m_file;       /** file handle.                          */
+    void                          *m_mapping;    /** file mapping handle.                  */
+#else
+    int                            m_descriptor; /** file descriptor.                      */
+#endif
+};
+
+#endif // MAPPEDFILE_H_
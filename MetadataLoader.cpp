@@ -0,0 +1,223 @@
+/*
+ File: MetadataLoader.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <CacheHints.h>
+#include <MetadataLoader.h>
+#include <ScanCache.h>
+
+// Qt
+#include <QThread>
+
+// C++
+#include <algorithm>
+#include <set>
+
+//----------------------------------------------------------------
+MetadataLoader::MetadataLoader(QObject *parent)
+: QObject      {parent}
+, m_next       {0}
+, m_first      {0}
+, m_last       {0}
+, m_running    {0}
+, m_stop       {false}
+, m_cacheWindow{0}
+, m_checksum   {false}
+{
+}
+
+//----------------------------------------------------------------
+MetadataLoader::~MetadataLoader()
+{
+  stop();
+}
+
+//----------------------------------------------------------------
+void MetadataLoader::start(const std::vector<OGGData> &streams)
+{
+  stop();
+
+  m_streams = streams;
+  m_taken.assign(m_streams.size(), false);
+  m_pending.clear();
+  for(size_t i = 0; i < m_streams.size(); ++i)
+  {
+    m_taken[i] = m_streams[i].hasInfo;
+    if(!m_taken[i]) ++m_pending[m_streams[i].container];
+  }
+
+  m_next    = 0;
+  m_first   = 0;
+  m_last    = 0;
+  m_stop    = false;
+
+  if(std::find(m_taken.cbegin(), m_taken.cend(), false) == m_taken.cend()) return;
+
+  // reading the information is mostly parsing, half of the cores leaves the interface responsive.
+  const auto threadsNum = std::max(1, QThread::idealThreadCount() / 2);
+  m_running = threadsNum;
+
+  for(int i = 0; i < threadsNum; ++i)
+  {
+    auto thread = QThread::create([this]() { run(); });
+    m_threads.push_back(thread);
+    thread->start(QThread::LowestPriority);
+  }
+}
+
+//----------------------------------------------------------------
+void MetadataLoader::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+
+  for(auto thread: m_threads)
+  {
+    thread->wait();
+    delete thread;
+  }
+
+  m_threads.clear();
+}
+
+//----------------------------------------------------------------
+void MetadataLoader::prioritize(const unsigned int first, const unsigned int last)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_first = first;
+  m_last  = std::min<unsigned int>(last, m_streams.size());
+}
+
+//----------------------------------------------------------------
+bool MetadataLoader::next(unsigned int &index)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(m_stop) return false;
+
+  for(auto i = m_first; i < m_last; ++i)
+  {
+    if(!m_taken[i])
+    {
+      m_taken[i] = true;
+      m_first = i + 1;
+      index = i;
+      return true;
+    }
+  }
+
+  while(m_next < m_streams.size())
+  {
+    const auto i = m_next++;
+    if(!m_taken[i])
+    {
+      m_taken[i] = true;
+      index = i;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//----------------------------------------------------------------
+void MetadataLoader::run()
+{
+  unsigned int index = 0;
+  while(next(index))
+  {
+    // the streams are not modified while reading, only the taken flags and the information of
+    // the read ones. Page faults of the mapping read ahead a lot more than the information needs.
+    OGGData data = m_streams[index];
+    OGGWrapper::oggInfo(data, m_cacheWindow == 0);
+
+    if(m_cacheWindow > 0) CacheHints::drop(data.container, data.start, data.end);
+
+    emit loaded(index, data.channels, data.rate, data.duration, QString::fromStdString(data.error));
+
+    // every thread writes only the information of the streams it takes, the last one of a
+    // container stores them all.
+    auto &stream = m_streams[index];
+    stream.channels = data.channels;
+    stream.rate     = data.rate;
+    stream.duration = data.duration;
+    stream.error    = data.error;
+    stream.hasInfo  = true;
+
+    bool complete = false;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      complete = (--m_pending[data.container] == 0);
+    }
+
+    if(complete) store(data.container);
+  }
+
+  bool last = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    last = (--m_running == 0) && !m_stop;
+  }
+
+  // the handles read ahead after the end of the streams.
+  if(last && m_cacheWindow > 0)
+  {
+    std::set<std::wstring> containers;
+    for(const auto &data: m_streams)
+      containers.insert(data.container);
+
+    for(const auto &container: containers)
+      CacheHints::drop(container);
+  }
+}
+
+//----------------------------------------------------------------
+void MetadataLoader::store(const std::wstring &container)
+{
+  // the cache has every found stream, not only the ones that passed the filters.
+  ScanCache cache(container);
+  cache.setChecksumValidation(m_checksum);
+
+  std::vector<OGGData> streams;
+  if(!cache.load(streams)) return;
+
+  // the information of the streams of other containers can be being written, only the ones of
+  // this container are compared after the name.
+  bool modified = false;
+  for(auto &stream: streams)
+  {
+    if(stream.hasInfo) continue;
+
+    auto equal = [&stream](const OGGData &data)
+    { return data.container == stream.container && data.start == stream.start && data.end == stream.end && data.hasInfo; };
+
+    const auto it = std::find_if(m_streams.cbegin(), m_streams.cend(), equal);
+    if(it == m_streams.cend()) continue;
+
+    stream.channels = it->channels;
+    stream.rate     = it->rate;
+    stream.duration = it->duration;
+    stream.error    = it->error;
+    stream.hasInfo  = true;
+    modified        = true;
+  }
+
+  if(modified) cache.save(streams);
+}
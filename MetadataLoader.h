@@ -0,0 +1,131 @@
+/*
+ File: MetadataLoader.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef METADATALOADER_H_
+#define METADATALOADER_H_
+
+// Project
+#include <OGGContainerWrapper.h>
+
+// Qt
+#include <QObject>
+#include <QString>
+
+// C++
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class QThread;
+
+/** \class MetadataLoader
+ * \brief Reads the information of the found streams in several low priority threads,
+ *        the streams of the requested range first and the rest in order. The information
+ *        of a container is stored in its scan cache when all its streams have been read.
+ *
+ */
+class MetadataLoader
+: public QObject
+{
+    Q_OBJECT
+  public:
+    /** \brief MetadataLoader class constructor.
+     * \param[in] parent Raw pointer of the QObject parent of this one.
+     *
+     */
+    explicit MetadataLoader(QObject *parent = nullptr);
+
+    /** \brief MetadataLoader class virtual destructor.
+     *
+     */
+    virtual ~MetadataLoader();
+
+    /** \brief Stops reading the information of the previous streams and begins with the given ones.
+     * \param[in] streams Streams to read, the ones with the information already read are skipped.
+     *
+     */
+    void start(const std::vector<OGGData> &streams);
+
+    /** \brief Stops reading and waits for the threads to finish.
+     *
+     */
+    void stop();
+
+    /** \brief Reads the streams in the [first, last) range before the rest.
+     * \param[in] first First stream index.
+     * \param[in] last Index after the last stream.
+     *
+     */
+    void prioritize(const unsigned int first, const unsigned int last);
+
+    /** \brief Sets the size of the system cache used by the containers, the data of the streams is
+     *         released from the cache after reading their information. Must be set before starting.
+     * \param[in] bytes Size in bytes, 0 for no limit.
+     *
+     */
+    void setCacheWindow(const unsigned long long bytes)
+    { m_cacheWindow = bytes; }
+
+    /** \brief Sets if the checksum of the pages was verified in the scan of the streams, to find
+     *         their scan cache. Must be set before starting.
+     * \param[in] value True if verified and false otherwise.
+     *
+     */
+    void setChecksumValidation(const bool value)
+    { m_checksum = value; }
+
+  signals:
+    void loaded(unsigned int index, int channels, int rate, double duration, QString error);
+
+  private:
+    /** \brief Reads streams until there are no more or stopped.
+     *
+     */
+    void run();
+
+    /** \brief Returns the index of the next stream to read and marks it as taken, or false if
+     *         there are none left.
+     * \param[out] index Stream index.
+     *
+     */
+    bool next(unsigned int &index);
+
+    /** \brief Stores the information of the streams of the given container in its scan cache, if
+     *         the cache has the results of the scan.
+     * \param[in] container Container file name.
+     *
+     */
+    void store(const std::wstring &container);
+
+    std::mutex                           m_mutex;       /** protects the reading state.              */
+    std::vector<OGGData>                 m_streams;     /** streams to read.                         */
+    std::vector<char>                    m_taken;       /** true if the stream has been taken.       */
+    std::map<std::wstring, unsigned int> m_pending;     /** streams not read yet of each container.  */
+    unsigned int                         m_next;        /** next stream to read in order.            */
+    unsigned int                         m_first;       /** first stream of the prioritized range.   */
+    unsigned int                         m_last;        /** index after the last prioritized stream. */
+    unsigned int                         m_running;     /** number of threads still reading.         */
+    bool                                 m_stop;        /** true to stop reading.                    */
+    unsigned long long                   m_cacheWindow; /** system cache window, 0 for no limit.     */
+    bool                                 m_checksum;    /** true if the checksums were verified.     */
+    std::vector<QThread *>               m_threads;     /** reading threads.                         */
+};
+
+#endif // METADATALOADER_H_
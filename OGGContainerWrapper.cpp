@@ -19,56 +19,129 @@
 
 // Project
 #include <OGGContainerWrapper.h>
+#include <VorbisProbe.h>
 
 // C++
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <codecvt>
+#include <cstring>
 #include <locale>
 #include <cassert>
+#include <map>
+#include <thread>
 
 using namespace OGGWrapper;
 
+/** \brief Fills the information of the stream read by the given wrapper. Returns true on success.
+ * \param[inout] data OGG file data.
+ * \param[in] wrapper Wrapper of the stream.
+ *
+ */
+static bool readInfo(OGGData &data, OGGContainerWrapper &wrapper);
+
 //----------------------------------------------------------------
-OGGWrapper::OGGContainerWrapper::OGGContainerWrapper(const OGGData& data)
+OGGWrapper::OGGContainerWrapper::OGGContainerWrapper(const OGGData& data, const bool mapped)
 : m_data    (data)
 , m_position{0}
+, m_uses    {0}
 {
-  m_container = std::ifstream{ws2s(m_data.container), std::ios_base::in|std::ios_base::binary};
+  const auto size = m_data.end - m_data.start;
+  auto file = mapped ? MappedFile::open(m_data.container) : nullptr;
+
+  // map only the stream, without going over the window size if the container is not fully mapped.
+  if(file && size > 0 && (file->isFullyMapped() || size <= MappedFile::windowSize()))
+    m_region = file->map(m_data.start, size);
+
+  if(!m_region)
+    m_file = FileHandle::open(m_data.container);
 }
 
 //----------------------------------------------------------------
 OGGWrapper::OGGContainerWrapper::~OGGContainerWrapper()
 {
-  if(m_container.is_open())
-    m_container.close();
+}
+
+//----------------------------------------------------------------
+const std::vector<unsigned char> *OGGWrapper::OGGContainerWrapper::block(const unsigned long long index)
+{
+  auto oldest = &m_blocks[0];
+  for(auto &cached: m_blocks)
+  {
+    if(!cached.data.empty() && cached.index == index)
+    {
+      cached.used = ++m_uses;
+      return &cached.data;
+    }
+
+    if(cached.used < oldest->used) oldest = &cached;
+  }
+
+  // the stream data is not needed after its end.
+  const auto position = index * BLOCK_SIZE;
+  const auto size = static_cast<size_t>(std::min<unsigned long long>(BLOCK_SIZE, m_data.end - position));
+
+  oldest->data.resize(size);
+  const auto bytesRead = m_file->read(oldest->data.data(), size, position);
+  if(bytesRead <= 0)
+  {
+    oldest->data.clear();
+    oldest->used = 0;
+    return nullptr;
+  }
+
+  oldest->data.resize(bytesRead);
+  oldest->index = index;
+  oldest->used  = ++m_uses;
+
+  return &oldest->data;
 }
 
 //----------------------------------------------------------------
 size_t OGGWrapper::OGGContainerWrapper::read(void* ptr, size_t size, size_t nmemb)
 {
-  if(!m_container.is_open()) return 0;
+  if(m_region)
+  {
+    const auto streamSize = static_cast<ogg_int64_t>(m_region->size());
+    if(m_position >= streamSize) return 0;
 
-  m_container.seekg(m_data.start + m_position);
+    const auto readSize = std::min<ogg_int64_t>(nmemb * size, streamSize - m_position);
+    std::memcpy(ptr, m_region->data() + m_position, readSize);
+    m_position += readSize;
 
-  auto readSize = nmemb * size;
-  const auto fileSize = m_data.end-m_data.start;
+    return readSize;
+  }
 
-  if(fileSize < m_position + readSize)
-    readSize = fileSize - m_position;
+  if(!m_file) return 0;
 
-  if(readSize > 0)
+  const auto streamSize = static_cast<ogg_int64_t>(m_data.end - m_data.start);
+  if(m_position >= streamSize) return 0;
+
+  const auto readSize = static_cast<size_t>(std::min<ogg_int64_t>(nmemb * size, streamSize - m_position));
+  auto buffer = reinterpret_cast<unsigned char *>(ptr);
+
+  size_t done = 0;
+  while(done < readSize)
   {
-    m_container.read(reinterpret_cast<char *>(ptr), readSize);
-    m_position += m_container.gcount();
+    const auto position = m_data.start + m_position;
+    const auto data = block(position / BLOCK_SIZE);
+    const auto offset = static_cast<size_t>(position % BLOCK_SIZE);
+    if(!data || offset >= data->size()) break;
+
+    const auto count = std::min(readSize - done, data->size() - offset);
+    std::memcpy(buffer + done, data->data() + offset, count);
+    done += count;
+    m_position += count;
   }
 
-  return readSize;
+  return done;
 }
 
 //----------------------------------------------------------------
 int OGGWrapper::OGGContainerWrapper::seek(ogg_int64_t offset, int whence)
 {
-  if(!m_container.is_open()) return -1;
+  if(!isOpen()) return -1;
   
   ogg_int64_t filesize = m_data.end-m_data.start;
 
@@ -150,9 +223,73 @@ long OGGWrapper::tell(void* datasource)
 }
 
 //----------------------------------------------------------------
-bool OGGWrapper::oggInfo(OGGData& data)
+bool OGGWrapper::oggInfo(OGGData& data, const bool mapped)
+{
+  OGGContainerWrapper wrapper{data, mapped};
+
+  return readInfo(data, wrapper);
+}
+
+//----------------------------------------------------------------
+bool OGGWrapper::oggInfo(std::vector<OGGData> &streams, unsigned int threads, const bool mapped, InfoCallback callback)
 {
-  OGGContainerWrapper wrapper{data};
+  std::vector<size_t> pending;
+  for(size_t i = 0; i < streams.size(); ++i)
+    if(!streams[i].hasInfo) pending.push_back(i);
+
+  if(pending.empty()) return false;
+
+  if(threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+  threads = std::min<size_t>(threads, pending.size());
+
+  std::atomic<size_t> next{0};
+
+  // every stream is only modified by the thread that takes it.
+  auto worker = [&]()
+  {
+    // the handles of the containers are kept open while reading.
+    std::map<std::wstring, std::shared_ptr<MappedFile>> mappings;
+    std::map<std::wstring, std::shared_ptr<FileHandle>> files;
+
+    for(auto i = next++; i < pending.size(); i = next++)
+    {
+      auto &data = streams[pending[i]];
+
+      if(mapped && mappings.find(data.container) == mappings.end())
+        mappings.emplace(data.container, MappedFile::open(data.container));
+
+      if(!mapped && files.find(data.container) == files.end())
+        files.emplace(data.container, FileHandle::open(data.container));
+
+      OGGContainerWrapper wrapper{data, mapped};
+      readInfo(data, wrapper);
+
+      if(callback) callback(data);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for(unsigned int i = 1; i < threads; ++i)
+    workers.emplace_back(worker);
+
+  worker();
+
+  for(auto &thread: workers)
+    thread.join();
+
+  return true;
+}
+
+//----------------------------------------------------------------
+bool readInfo(OGGData &data, OGGContainerWrapper &wrapper)
+{
+  data.hasInfo = true;
+
+  // most streams don't need to be opened with libvorbis.
+  if(VorbisProbe::probe(data, wrapper)) return true;
+
+  wrapper.seek(0, SEEK_SET);
+
   ov_callbacks callbacks;
   callbacks.read_func  = OGGWrapper::read;
   callbacks.seek_func  = OGGWrapper::seek;
@@ -194,6 +331,7 @@ bool OGGWrapper::oggInfo(OGGData& data)
   if(!info)
   {
     data.error = std::string("Unable to get ogg info struct.");
+    ov_clear(&oggFile);
     return false;
   }
 
@@ -201,6 +339,8 @@ bool OGGWrapper::oggInfo(OGGData& data)
   data.rate        = info->rate;
   data.duration    = ov_time_total(&oggFile, -1);
 
+  ov_clear(&oggFile);
+
   return true;
 }
 
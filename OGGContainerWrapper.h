@@ -20,6 +20,10 @@
 #ifndef OGGCONTAINERWRAPPER_H_
 #define OGGCONTAINERWRAPPER_H_
 
+// Project
+#include <FileHandle.h>
+#include <MappedFile.h>
+
 // libvorbis
 #include <vorbis/vorbisfile.h>
 
@@ -27,7 +31,9 @@
 #include <string>
 
 // C++
-#include <fstream>
+#include <array>
+#include <functional>
+#include <vector>
 
 struct OGGData
 {
@@ -39,15 +45,18 @@ struct OGGData
   double             duration;  /** file duration in seconds.                  */
   std::string        error;     /** empty on success, error message otherwise. */
   std::wstring       name;      /** name given by the user or empty otherwise. */
+  bool               hasInfo;   /** true if the information has been read.     */
 
-  OGGData(): start{0}, end{0}, channels{0}, rate{0}, duration{0} {};
+  OGGData(): start{0}, end{0}, channels{0}, rate{0}, duration{0}, hasInfo{false} {};
 };
 
 namespace OGGWrapper
 {
   /** \class OGGContainerWrapper
    * \brief Wrapper around a OGG file container to provide the needed functions
-   *        to operate those files with libvorbis library.
+   *        to operate those files with libvorbis library. The stream is read from
+   *        the memory mapping of the container when possible, otherwise from a
+   *        shared handle of the container through a small cache of blocks.
    *
    */
   class OGGContainerWrapper
@@ -55,9 +64,11 @@ namespace OGGWrapper
     public:
       /** \brief OGGContainerWrapper class constructor.
        * \param[in] data OGG file data.
+       * \param[in] mapped True to read the stream from the memory mapped container and false to
+       *            read it from the file, with less reading ahead from the system.
        *
        */
-      OGGContainerWrapper(const OGGData &data);
+      OGGContainerWrapper(const OGGData &data, const bool mapped = true);
 
       /** \brief OGGContainerWrapper class virtual destructor.
        *
@@ -90,9 +101,43 @@ namespace OGGWrapper
       long tell();
 
     private:
-      const OGGData m_data;      /** OGG file data.         */
-      ogg_int64_t   m_position;  /** current file position. */
-      std::ifstream m_container; /** container file stream. */
+      /** \brief Returns true if the stream can be read.
+       *
+       */
+      bool isOpen() const
+      { return m_region || m_file; }
+
+      /** \brief Returns the cached block with the given index, reading it if not cached, or
+       *         nullptr on error.
+       * \param[in] index Block index in the container.
+       *
+       */
+      const std::vector<unsigned char> *block(const unsigned long long index);
+
+      /** \struct Block
+       * \brief Block of the container read from the file.
+       *
+       */
+      struct Block
+      {
+        unsigned long long         index; /** block index in the container.   */
+        std::vector<unsigned char> data;  /** block data, empty if not read.  */
+        unsigned long long         used;  /** last use to find the oldest one. */
+
+        Block(): index{0}, used{0} {};
+      };
+
+      // libvorbis reads 2 KB at a time, the headers sequentially, then the end of the stream
+      // going back and then bisecting to find the links. A block for every part is enough.
+      static constexpr size_t BLOCK_SIZE   = 16384; /** size of the cached blocks. */
+      static constexpr size_t CACHE_BLOCKS = 4;     /** number of cached blocks.   */
+
+      const OGGData                             m_data;     /** OGG file data.                              */
+      ogg_int64_t                               m_position; /** current file position.                      */
+      std::shared_ptr<const MappedFile::Region> m_region;   /** mapped stream data or nullptr if not mapped. */
+      std::shared_ptr<FileHandle>               m_file;     /** container handle if not mapped.              */
+      std::array<Block, CACHE_BLOCKS>           m_blocks;   /** cached blocks if not mapped.                 */
+      unsigned long long                        m_uses;     /** number of uses of the cached blocks.         */
   };
 
   /** \brief Callback methods as defined in ov_callbacks structure (vorbisfile.h line 39).
@@ -107,9 +152,26 @@ namespace OGGWrapper
 
   /** \brief Returns true if the file could be accessed and decoded, fills the relevant information in the OGGData struct.
    * \param[in] data OGG file data.
+   * \param[in] mapped True to read the stream from the memory mapped container.
+   *
+   */
+  bool oggInfo(OGGData &data, const bool mapped = true);
+
+  /** \brief Callback called after reading the information of a stream, from the reading threads.
+   *
+   */
+  using InfoCallback = std::function<void(const OGGData &)>;
+
+  /** \brief Reads the information of the streams that don't have it in several threads, every
+   *         one with its own handles of the containers. The streams keep their order. Returns
+   *         true if any stream has been read.
+   * \param[inout] streams OGG files data.
+   * \param[in] threads Number of threads, 0 to use one per core.
+   * \param[in] mapped True to read the streams from the memory mapped containers.
+   * \param[in] callback Callback called after reading every stream or nullptr.
    *
    */
-  bool oggInfo(OGGData &data);
+  bool oggInfo(std::vector<OGGData> &streams, unsigned int threads = 0, const bool mapped = true, InfoCallback callback = nullptr);
 
   /** \brief Helper to convert string to wstring
    * \param[in] str string to convert.
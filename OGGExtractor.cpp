@@ -19,6 +19,7 @@
 
 // Project
 #include <AboutDialog.h>
+#include <MetadataLoader.h>
 #include <OGGExtractor.h>
 #include <TableModel.h>
 
@@ -31,7 +32,6 @@
 #include <QAbstractItemModel>
 #include <QBuffer>
 #include <QCheckBox>
-#include <QFile>
 #include <QAudioFormat>
 #include <QFileDialog>
 #include <QHBoxLayout>
@@ -68,6 +68,7 @@ OGGExtractor::OGGExtractor(QWidget *parent, Qt::WindowFlags flags)
 , m_audio         {nullptr}
 , m_taskBarButton {this}
 , m_thread        {nullptr}
+, m_extractThread {nullptr}
 , m_audioDevice   {QMediaDevices::defaultAudioOutput()}
 {
   setupUi(this);
@@ -103,6 +104,11 @@ OGGExtractor::OGGExtractor(QWidget *parent, Qt::WindowFlags flags)
   m_pageCount->setText("");
   m_pageCount->setEnabled(false);
 
+  m_threads->setMaximum(std::max(1, QThread::idealThreadCount()));
+  m_extractThreads->setMaximum(std::max(1, QThread::idealThreadCount()));
+
+  m_metadata = new MetadataLoader(this);
+
   connectSignals();
 
   setMinimumWidth(1000);
@@ -112,7 +118,21 @@ OGGExtractor::OGGExtractor(QWidget *parent, Qt::WindowFlags flags)
 //----------------------------------------------------------------
 OGGExtractor::~OGGExtractor()
 {
+  // the threads can't outlive the window.
+  if(m_thread)
+  {
+    m_thread->abort();
+    m_thread->wait();
+  }
+
+  if(m_extractThread)
+  {
+    m_extractThread->abort();
+    m_extractThread->wait();
+  }
+
   stopBuffer();
+  m_metadata->stop();
   m_tableModel->clearModel();
   m_soundFiles.clear();
   m_soundSelected.clear();
@@ -172,6 +192,9 @@ void OGGExtractor::connectSignals()
 
   connect(m_next,         SIGNAL(clicked()), 
           this,           SLOT(onMovementButtonClicked()));
+
+  connect(m_metadata,     SIGNAL(loaded(unsigned int, int, int, double, QString)),
+          this,           SLOT(onMetadataLoaded(unsigned int, int, int, double, QString)));
 }
 
 //----------------------------------------------------------------
@@ -258,6 +281,9 @@ void OGGExtractor::cancelScan()
   if(m_thread)
     m_thread->abort();
 
+  if(m_extractThread)
+    m_extractThread->abort();
+
   m_cancelProcess = true;
 
   m_cancel->setEnabled(false);
@@ -274,6 +300,7 @@ void OGGExtractor::scanContainers()
 
   stopBuffer();
 
+  m_metadata->stop();
   m_tableModel->clearModel();
   m_soundFiles.clear();
   m_soundSelected.clear();
@@ -288,7 +315,7 @@ void OGGExtractor::scanContainers()
 
   if(m_size->isChecked())
   {
-    m_thread->setMinimumStreamDuration(m_minimumSize->value());
+    m_thread->setMinimumStreamSize(m_minimumSize->value());
   }
 
   if(m_time->isChecked())
@@ -296,6 +323,14 @@ void OGGExtractor::scanContainers()
     m_thread->setMinimumStreamDuration(m_minimumTime->value());
   }
 
+  m_thread->setThreads(m_threads->value());
+  m_thread->setChecksumValidation(m_checksum->isChecked());
+  m_thread->setReadMode(m_directIO->isChecked() ? ReadMode::DIRECT : ReadMode::ASYNC);
+  m_thread->setCacheWindow(static_cast<unsigned long long>(m_cacheWindow->value()) * 1024 * 1024);
+
+  // interrupted scans of the same containers continue where they were.
+  m_thread->setCheckpoints(true);
+
   setProgress(0,"Scanning... %p%");
   connect(m_thread.get(), SIGNAL(progress(int)), this, SLOT(onProgressSignaled(int)));
   connect(m_thread.get(), SIGNAL(error(const QString, const QString)), this, SLOT(onErrorSignaled(const QString, const QString)));
@@ -307,70 +342,63 @@ void OGGExtractor::scanContainers()
 //----------------------------------------------------------------
 void OGGExtractor::extractFiles()
 {
-  auto destination = QFileDialog::getExistingDirectory(centralWidget(), tr("Select destination directory"), QDir::currentPath());
+  const auto toArchive = m_archive->isChecked();
 
-  if(destination.isEmpty()) return;
+  QString destination;
+  if(toArchive)
+    destination = QFileDialog::getSaveFileName(centralWidget(), tr("Select destination archive"), QDir::currentPath(), tr("Tar archives (*.tar)"));
+  else
+    destination = QFileDialog::getExistingDirectory(centralWidget(), tr("Select destination directory"), QDir::currentPath());
 
-  startProcess();
+  if(destination.isEmpty()) return;
 
-  QApplication::setOverrideCursor(Qt::WaitCursor);
+  QDir dir(destination);
 
-  int progressValue = 0;
-  setProgress(0, "Extracting selected files... %p%");
-  for(unsigned int i = 0; i < m_soundFiles.size() && !m_cancelProcess; ++i)
+  std::vector<OGGData> streams;
+  QStringList filenames;
+  for(unsigned int i = 0; i < m_soundFiles.size(); ++i)
   {
-    const int currentProgress = 100.0*(static_cast<float>(i/m_soundFiles.size()));
-    if(progressValue != currentProgress)
-    {
-      progressValue = currentProgress;
-      setProgress(currentProgress);
-    }
-
-    const auto data = m_soundFiles.at(i);
-    const auto isChecked = m_soundSelected.at(i);
-    if(isChecked && data.error.empty())
-    {
-      auto name = m_tableModel->dataDisplayRole(data, 1).toString(); // Filename.
+    const auto &data = m_soundFiles.at(i);
+    if(!m_soundSelected.at(i) || !data.error.empty()) continue;
 
-      // play safe with names, only common characters to avoid unicode.
-      name = name.replace(QRegularExpression("[^a-zA-Z0-9_- ]"),QString(""));
+    auto name = m_tableModel->dataDisplayRole(data, 1).toString(); // Filename.
 
-      QDir dir(destination);
-      QFile file(dir.absoluteFilePath(tr("%1.ogg").arg(name)));
+    // play safe with names, only common characters to avoid unicode.
+    name = name.replace(QRegularExpression("[^a-zA-Z0-9_- ]"),QString(""));
 
-      if(!file.open(QFile::Truncate|QFile::WriteOnly))
-      {
-        errorDialog(tr("Couldn't create file '%1'").arg(file.fileName()), tr("Error: %1").arg(file.errorString()));
-        continue;
-      }
-
-      const auto qContainer = QString::fromStdWString(data.container);
-      QFile source(qContainer);
-
-      if(!source.open(QFile::ReadOnly))
-      {
-        errorDialog(tr("Couldn't open container file '%1'").arg(qContainer), tr("Error: %1").arg(source.errorString()));
-        return;
-      }
+    streams.push_back(data);
+    if(toArchive)
+      filenames << tr("%1.ogg").arg(name);
+    else
+      filenames << dir.absoluteFilePath(tr("%1.ogg").arg(name));
+  }
 
-      source.seek(data.start);
-      file.write(source.read(data.end-data.start));
+  if(streams.empty()) return;
 
-      if(!file.flush())
-      {
-        errorDialog(tr("Error flushing '%1'").arg(file.fileName()), tr("Error: %1").arg(file.errorString()));
-        return;
-      }
+  startProcess();
+  m_scan->setEnabled(false);
+  m_extract->setEnabled(false);
 
-      file.close();
-      source.close();
-    }
+  if(m_extractThread)
+  {
+    m_extractThread->abort();
+    m_extractThread->wait();
   }
 
-  endProcess();
-  setProgress(0, "%p%");
+  // the data is copied by the system when possible, in a thread to keep the interface responsive.
+  m_extractThread = std::make_shared<ExtractThread>(streams, filenames, this);
+  m_extractThread->setReleaseCache(m_cacheWindow->value() > 0);
+  m_extractThread->setSequential(m_sequential->isChecked());
+  m_extractThread->setThreads(m_extractThreads->value());
+  if(toArchive) m_extractThread->setArchive(destination);
+  m_extractThread->setDurability(static_cast<FileCopy::Durability>(m_durability->currentIndex()));
 
-  QApplication::restoreOverrideCursor();
+  setProgress(0, "Extracting selected files... %p%");
+  connect(m_extractThread.get(), SIGNAL(progress(int)), this, SLOT(onProgressSignaled(int)));
+  connect(m_extractThread.get(), SIGNAL(error(const QString, const QString)), this, SLOT(onErrorSignaled(const QString, const QString)));
+  connect(m_extractThread.get(), SIGNAL(finished()), this, SLOT(onExtractionFinished()));
+
+  m_extractThread->start();
 }
 
 //----------------------------------------------------------------
@@ -523,6 +551,13 @@ void OGGExtractor::onPlayButtonPressed()
 
     m_playButton = button;
 
+    // the information may not have been read in the background yet.
+    if(!m_soundFiles.at(index).hasInfo)
+    {
+      OGGWrapper::oggInfo(m_soundFiles.at(index));
+      m_tableModel->updateRow(index);
+    }
+
     auto data = m_soundFiles.at(index);
     m_sample = decodeOGG(data);
 
@@ -735,6 +770,11 @@ void OGGExtractor::onThreadFinished()
   m_tableModel->setModelData(m_soundFiles);
   insertWidgetsInTable();
 
+  m_metadata->setCacheWindow(static_cast<unsigned long long>(m_cacheWindow->value()) * 1024 * 1024);
+  m_metadata->setChecksumValidation(m_checksum->isChecked());
+  m_metadata->start(m_soundFiles);
+  prioritizeCurrentPage();
+
   if(!m_soundFiles.empty())
   {
     const auto pageSize = m_tableModel->pageSize();
@@ -755,6 +795,26 @@ void OGGExtractor::onThreadFinished()
   QApplication::restoreOverrideCursor();
 }
 
+//----------------------------------------------------------------
+void OGGExtractor::onExtractionFinished()
+{
+  m_cancel->setEnabled(false);
+  m_scan->setEnabled(true);
+  endProcess();
+
+  if(!m_soundFiles.empty())
+  {
+    const auto currentPage = m_tableModel->page();
+    m_previous->setEnabled(currentPage != 0);
+    m_next->setEnabled(currentPage != m_tableModel->maxPage());
+    m_pageCount->setText(QString("%1 of %2").arg(currentPage + 1).arg(m_tableModel->maxPage()));
+  }
+
+  checkSelectedFiles();
+
+  m_extractThread = nullptr;
+}
+
 //----------------------------------------------------------------
 void OGGExtractor::onProgressSignaled(int value)
 {
@@ -785,9 +845,34 @@ void OGGExtractor::onMovementButtonClicked()
     m_pageCount->setText(QString("%1 of %2").arg(currentPage + 1).arg(m_tableModel->maxPage()));
     insertWidgetsInTable();
     m_filesTable->scrollTo(m_tableModel->index(0,0), QTableView::ScrollHint::EnsureVisible);
+
+    prioritizeCurrentPage();
   }
 }
 
+//----------------------------------------------------------------
+void OGGExtractor::prioritizeCurrentPage()
+{
+  const auto first = m_tableModel->page() * m_tableModel->pageSize();
+  m_metadata->prioritize(first, first + m_tableModel->pageItems());
+}
+
+//----------------------------------------------------------------
+void OGGExtractor::onMetadataLoaded(unsigned int index, int channels, int rate, double duration, QString error)
+{
+  // the stream may have been read to play it before.
+  if(index >= m_soundFiles.size() || m_soundFiles.at(index).hasInfo) return;
+
+  auto &data = m_soundFiles.at(index);
+  data.channels = channels;
+  data.rate     = rate;
+  data.duration = duration;
+  data.error    = error.toStdString();
+  data.hasInfo  = true;
+
+  m_tableModel->updateRow(index);
+}
+
 //----------------------------------------------------------------
 void OGGExtractor::onAudioNotify()
 {
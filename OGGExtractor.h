@@ -23,6 +23,7 @@
 #include "ui_OGGExtractor.h"
 
 // Project
+#include <ExtractThread.h>
 #include <OGGContainerWrapper.h>
 #include <ScanThread.h>
 #include <external/QTaskbarButton.h>
@@ -38,6 +39,7 @@ class QWinTaskbarButton;
 class QAudioSink;
 class QAudioBuffer;
 class TableModel;
+class MetadataLoader;
 
 /** \class OGGExtractor
  * \brief Main dialog class.
@@ -85,7 +87,7 @@ class OGGExtractor
      */
     void scanContainers();
 
-    /** \brief Shows the file dialog to select destination and extracts the found music files.
+    /** \brief Shows the file dialog to select destination and extracts the selected music files in a thread.
      *
      */
     void extractFiles();
@@ -95,7 +97,7 @@ class OGGExtractor
      */
     void onContainerSelectionChanged();
 
-    /** \brief Cancels scanning process.
+    /** \brief Cancels scanning or extraction process.
      *
      */
     void cancelScan();
@@ -142,6 +144,11 @@ class OGGExtractor
      */
     void onThreadFinished();
 
+    /** \brief Updates the UI and frees the thread when the extraction ends.
+     *
+     */
+    void onExtractionFinished();
+
     /** \brief Shows a dialog with the error message.
      * \param[in] message Error message.
      * \param[in] details Error details.
@@ -165,6 +172,16 @@ class OGGExtractor
      */
     void onAudioNotify();
 
+    /** \brief Stores the information of a stream read in the background and updates the table.
+     * \param[in] index Stream index.
+     * \param[in] channels Number of channels.
+     * \param[in] rate Stream rate.
+     * \param[in] duration Duration in seconds.
+     * \param[in] error Error message or empty if none.
+     *
+     */
+    void onMetadataLoaded(unsigned int index, int channels, int rate, double duration, QString error);
+
   private:
     /** \brief Helper method that connects the signals of the UI with its correspondent slots.
      *
@@ -219,6 +236,11 @@ class OGGExtractor
      */
     void playBufffer(std::shared_ptr<QByteArray> pcmBuffer, const OGGData &data);
 
+    /** \brief Reads the information of the streams of the current page before the rest.
+     *
+     */
+    void prioritizeCurrentPage();
+
     /** \brief Helper method to set operation progress.
      * \param[in] value Progress value in [0,100];
      * \param format Progress bar text format.ABC
@@ -238,6 +260,8 @@ class OGGExtractor
     std::shared_ptr<QAudioSink>   m_audio;           /** sound player.                                                */
     QTaskBarButton                m_taskBarButton; /** taskbar progress widget.                                     */
     std::shared_ptr<ScanThread>   m_thread;        /** thread for scanning containers.                              */
+    std::shared_ptr<ExtractThread> m_extractThread; /** thread for extracting streams.                              */
     TableModel                   *m_tableModel;    /** table internal model.                                        */
+    MetadataLoader               *m_metadata;      /** reads the information of the streams in the background.      */
     QAudioDevice                  m_audioDevice;   /** Default audio device.                                        */
 };
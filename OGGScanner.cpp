@@ -0,0 +1,272 @@
+/*
+ File: OGGScanner.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <OGGScanner.h>
+#include <CaptureSearch.h>
+#include <PageChecksum.h>
+
+// C++
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+const unsigned char OGG_CAPTURE[5] = { 'O', 'g', 'g', 'S', 0 }; /** Ogg header signature and version. */
+
+//----------------------------------------------------------------
+OGGScanner::OGGScanner(StreamCallback callback, unsigned long long offset, unsigned long long limit)
+: m_callback   {callback}
+, m_offset     {offset}
+, m_limit      {limit}
+, m_carry      (2 * MAX_HEADER_SIZE)
+, m_carrySize  {0}
+, m_position   {offset}
+, m_pageWalking{true}
+, m_checksum   {false}
+, m_walking    {false}
+, m_resume     {limit}
+{
+}
+
+//----------------------------------------------------------------
+void OGGScanner::scan(const unsigned char *data, size_t size)
+{
+  if(size == 0) return;
+
+  if(m_carrySize > 0)
+  {
+    // stitch the unscanned bytes of the last block with the beginning of this one.
+    const auto extra = std::min(size, lookahead());
+    std::memcpy(m_carry.data() + m_carrySize, data, extra);
+
+    const auto stitchSize = m_carrySize + extra;
+    const auto stop = scanBlock(m_carry.data(), stitchSize, m_carrySize, m_offset - m_carrySize, false);
+
+    if(stop < m_carrySize)
+    {
+      // only possible if the block is smaller than a header (or a page), keep everything for the next one.
+      assert(extra == size);
+      m_carrySize = stitchSize - stop;
+      std::memmove(m_carry.data(), m_carry.data() + stop, m_carrySize);
+      m_offset += size;
+      return;
+    }
+
+    m_carrySize = 0;
+  }
+
+  const auto stop = scanBlock(data, size, size, m_offset, false);
+  if(stop < size)
+  {
+    m_carrySize = size - stop;
+    assert(m_carrySize < lookahead());
+    std::memcpy(m_carry.data(), data + stop, m_carrySize);
+  }
+
+  m_offset += size;
+}
+
+//----------------------------------------------------------------
+void OGGScanner::finish()
+{
+  if(m_carrySize > 0)
+  {
+    scanBlock(m_carry.data(), m_carrySize, m_carrySize, m_offset - m_carrySize, true);
+    m_carrySize = 0;
+  }
+}
+
+//----------------------------------------------------------------
+void OGGScanner::setChecksumValidation(const bool value)
+{
+  assert(m_carrySize == 0);
+
+  m_checksum = value;
+  m_carry.resize(2 * lookahead());
+}
+
+//----------------------------------------------------------------
+OGGScanner::State OGGScanner::state() const
+{
+  // the unscanned bytes kept from the last block begin at the scan position.
+  State result;
+  result.position = m_position;
+  result.walking  = m_walking;
+  result.streams  = m_streams.entries();
+
+  return result;
+}
+
+//----------------------------------------------------------------
+void OGGScanner::restore(const State &state)
+{
+  assert(m_carrySize == 0);
+
+  m_offset   = state.position;
+  m_position = state.position;
+  m_walking  = state.walking;
+
+  m_streams.clear();
+  for(const auto &stream: state.streams)
+    m_streams.insert(stream.first, stream.second);
+}
+
+//----------------------------------------------------------------
+OGGScanner::ParseResult OGGScanner::parsePage(const unsigned char *data, size_t available, bool checksum, OGGPage &page)
+{
+  if(0 != std::memcmp(data, OGG_CAPTURE, std::min(available, sizeof(OGG_CAPTURE))))
+    return ParseResult::NO_PAGE;
+
+  if(available < HEADER_SIZE)
+    return ParseResult::NEED_MORE;
+
+  const size_t segments = data[26];
+  if(available < HEADER_SIZE + segments)
+    return ParseResult::NEED_MORE;
+
+  unsigned long long bodySize = 0;
+  for(size_t i = 0; i < segments; ++i)
+    bodySize += data[HEADER_SIZE + i];
+
+  page.size   = HEADER_SIZE + segments + bodySize;
+  page.flags  = data[5];
+  page.serial = static_cast<uint32_t>(data[14])         | (static_cast<uint32_t>(data[15]) << 8) |
+               (static_cast<uint32_t>(data[16]) << 16) | (static_cast<uint32_t>(data[17]) << 24);
+
+  if(checksum)
+  {
+    if(available < page.size)
+      return ParseResult::NEED_MORE;
+
+    if(!PageChecksum::isValid(data, page.size))
+      return ParseResult::NO_PAGE;
+  }
+
+  return ParseResult::PAGE;
+}
+
+//----------------------------------------------------------------
+bool OGGScanner::canSkip(const unsigned char *data, size_t available, const OGGPage &page) const
+{
+  if(page.size > available) return false;
+
+  // the parsed pages have already been verified.
+  if(m_checksum) return true;
+
+  // a byte by byte scan wouldn't find anything in the contents of the page either.
+  return CaptureSearch::find(data, available, 1, page.size) >= page.size;
+}
+
+//----------------------------------------------------------------
+size_t OGGScanner::scanBlock(const unsigned char *data, size_t size, size_t limit, unsigned long long base, bool final)
+{
+  // the scan continues after the last walked page, that can be after the given data.
+  if(m_position >= base + limit) return limit;
+
+  OGGPage page;
+  size_t position = m_position > base ? static_cast<size_t>(m_position - base) : 0;
+
+  while(position < limit)
+  {
+    if(!m_walking)
+    {
+      position = CaptureSearch::find(data, size, position, limit);
+      if(position >= limit) break;
+    }
+
+    switch(parsePage(data + position, size - position, m_checksum, page))
+    {
+      case ParseResult::PAGE:
+        page.offset = base + position;
+        onPage(page);
+
+        // the next page of the stream follows this one, skip the page contents. The size of a truncated page or
+        // a false positive can't be trusted, so the contents are only skipped if there isn't another page in them.
+        if(m_pageWalking && canSkip(data + position, size - position, page))
+        {
+          m_walking = true;
+          if(page.offset < m_limit && page.offset + page.size >= m_limit)
+            m_resume = page.offset + page.size;
+
+          // the skipped pages are complete in the given data.
+          position += page.size;
+          continue;
+        }
+
+        // scan from the next byte.
+        m_walking = false;
+        break;
+      case ParseResult::NEED_MORE:
+        if(!final)
+        {
+          m_position = base + position;
+          return position;
+        }
+        m_walking = false;
+        break;
+      default:
+        if(m_walking)
+        {
+          // lost the chain of pages, scan from here.
+          m_walking = false;
+          continue;
+        }
+        break;
+    }
+
+    ++position;
+  }
+
+  m_position = base + (m_walking ? position : limit);
+  return limit;
+}
+
+//----------------------------------------------------------------
+void OGGScanner::onPage(const OGGPage &page)
+{
+  if(page.offset >= m_limit) return;
+
+  if(m_pageListener) m_pageListener(page);
+
+  if(m_pageCallback)
+  {
+    if(page.flags & 0x06) m_pageCallback(page);
+    return;
+  }
+
+  addPage(page);
+}
+
+//----------------------------------------------------------------
+void OGGScanner::addPage(const OGGPage &page)
+{
+  // detected beginning of ogg file
+  if(page.flags & 0x02)
+  {
+    m_streams.insert(page.serial, page.offset);
+    return;
+  }
+
+  // detected ending of ogg file, the end includes the trailing segments.
+  unsigned long long beginning = 0;
+  if((page.flags & 0x04) && m_streams.take(page.serial, beginning))
+  {
+    if(m_callback) m_callback(beginning, page.offset + page.size);
+  }
+}
@@ -0,0 +1,244 @@
+/*
+ File: OGGScanner.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OGGSCANNER_H_
+#define OGGSCANNER_H_
+
+// Project
+#include <SerialTable.h>
+
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/** \struct OGGPage
+ * \brief Information of an Ogg page header found in the container.
+ *
+ */
+struct OGGPage
+{
+  unsigned long long offset; /** position of the page in the container.                 */
+  unsigned long long size;   /** page size including header, segment table and body.    */
+  uint32_t           serial; /** serial number of the logical bitstream of the page.    */
+  unsigned char      flags;  /** header type flags (0x01 continued, 0x02 BOS, 0x04 EOS). */
+
+  OGGPage(): offset{0}, size{0}, serial{0}, flags{0} {};
+};
+
+/** \class OGGScanner
+ * \brief Finds OGG streams in the consecutive blocks of a container. Every logical
+ *        bitstream is tracked by its serial number, so interleaved and multiplexed
+ *        streams are reported as separate ranges when their own ending page is found.
+ *        Page headers and segment tables are parsed in place from the given blocks, only
+ *        the bytes of a header (or of a page, if checksums are verified) split between
+ *        two blocks are copied to an internal buffer. When page walking is enabled the
+ *        pages are followed using their sizes, if there isn't a capture pattern in their
+ *        contents, and the bytes are scanned one by one only when the next page is not
+ *        where the previous one says.
+ *
+ */
+class OGGScanner
+{
+  public:
+    /** \brief Function called with the [start, end) range of every found stream.
+     *
+     */
+    using StreamCallback = std::function<void(unsigned long long start, unsigned long long end)>;
+
+    /** \brief Function called with the pages that change the stream state.
+     *
+     */
+    using PageCallback = std::function<void(const OGGPage &page)>;
+
+    /** \struct State
+     * \brief State of the scan between two blocks, enough to continue it later.
+     *
+     */
+    struct State
+    {
+      unsigned long long                                   position; /** container position of the next scan.    */
+      bool                                                 walking;  /** true if a page is expected there.       */
+      std::vector<std::pair<uint32_t, unsigned long long>> streams;  /** serials and beginnings of open streams. */
+
+      State(): position{0}, walking{false} {};
+    };
+
+    static constexpr size_t HEADER_SIZE     = 27;                /** fixed part of the page header.       */
+    static constexpr size_t MAX_HEADER_SIZE = HEADER_SIZE + 255;             /** header with the biggest lacing table. */
+    static constexpr size_t MAX_PAGE_SIZE   = MAX_HEADER_SIZE + 255 * 255; /** biggest page with header and body.    */
+
+    /** \brief OGGScanner class constructor.
+     * \param[in] callback Function to call for every found stream.
+     * \param[in] offset Position in the container of the first block to scan.
+     * \param[in] limit Pages at this position or after it are ignored.
+     *
+     */
+    explicit OGGScanner(StreamCallback callback, unsigned long long offset = 0, unsigned long long limit = ~0ULL);
+
+    /** \brief OGGScanner class virtual destructor.
+     *
+     */
+    virtual ~OGGScanner()
+    {}
+
+    /** \brief Scans the given block. Blocks must be given in order and without gaps.
+     * \param[in] data Block data.
+     * \param[in] size Block size in bytes.
+     *
+     */
+    void scan(const unsigned char *data, size_t size);
+
+    /** \brief Scans the bytes kept from the last block. Must be called once after
+     *         the last block of the container.
+     *
+     */
+    void finish();
+
+    /** \brief Sets a function to receive the beginning and ending pages found instead
+     *         of updating the stream state with them. Used to scan a container by parts
+     *         and later give the pages in order to another scanner with addPage().
+     * \param[in] callback Function to call for the beginning and ending pages.
+     *
+     */
+    void setPageCallback(PageCallback callback)
+    { m_pageCallback = callback; }
+
+    /** \brief Sets a function to receive every found page before it updates the stream state.
+     * \param[in] callback Function to call for every page.
+     *
+     */
+    void setPageListener(PageCallback callback)
+    { m_pageListener = callback; }
+
+    /** \brief Enables or disables following the chain of pages of a stream instead of
+     *         scanning every byte of the stream. Enabled by default.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setPageWalking(const bool value)
+    { m_pageWalking = value; }
+
+    /** \brief Enables or disables the verification of the checksum of the pages, pages with
+     *         a wrong checksum are ignored. Disabled by default. Must be set before scanning.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setChecksumValidation(const bool value);
+
+    /** \brief Returns the number of bytes after a position needed to parse a page there, the
+     *         biggest page if checksums are verified or the biggest header otherwise.
+     *
+     */
+    size_t lookahead() const
+    { return m_checksum ? MAX_PAGE_SIZE : MAX_HEADER_SIZE; }
+
+    /** \brief Updates the state of the streams with the given page. Pages must be given in order.
+     * \param[in] page Page information.
+     *
+     */
+    void addPage(const OGGPage &page);
+
+    /** \brief Returns the container position after the last block given to the scanner.
+     *
+     */
+    unsigned long long processed() const
+    { return m_offset; }
+
+    /** \brief Returns the position where the scan of the data after the limit must begin to
+     *         continue this scan: the next page of the chain if the limit was crossed while
+     *         walking pages, or the limit otherwise.
+     *
+     */
+    unsigned long long resumePosition() const
+    { return m_resume; }
+
+    /** \brief Returns the state of the scan after the last given block. The blocks of the
+     *         container after the state position are needed to continue the scan.
+     *
+     */
+    State state() const;
+
+    /** \brief Continues a scan from the given state, the next block must begin at the state
+     *         position. Must be called before scanning.
+     * \param[in] state Scan state.
+     *
+     */
+    void restore(const State &state);
+
+  private:
+    /** \brief Result of parsing the bytes at a given position.
+     *
+     */
+    enum class ParseResult: char { PAGE, NO_PAGE, NEED_MORE };
+
+    /** \brief Parses the page header at the beginning of the given data.
+     * \param[in] data Data pointer.
+     * \param[in] available Bytes available from the data pointer.
+     * \param[in] checksum True to verify the checksum of the page.
+     * \param[out] page Page information, only valid if the result is PAGE.
+     *
+     */
+    static ParseResult parsePage(const unsigned char *data, size_t available, bool checksum, OGGPage &page);
+
+    /** \brief Returns true if the contents of the given parsed page can be skipped: the page is
+     *         complete in the data and its checksum has been verified or there isn't a capture
+     *         pattern in it.
+     * \param[in] data Page data pointer.
+     * \param[in] available Bytes available from the data pointer.
+     * \param[in] page Page information.
+     *
+     */
+    bool canSkip(const unsigned char *data, size_t available, const OGGPage &page) const;
+
+    /** \brief Scans the positions [0, limit) of the given data for pages, starting at the
+     *         current scan position, and returns the position where the scan stopped because
+     *         the header was incomplete, or limit if every position was scanned.
+     * \param[in] data Data pointer.
+     * \param[in] size Size of the data in bytes.
+     * \param[in] limit Scan positions lower than limit.
+     * \param[in] base Position of the data in the container.
+     * \param[in] final True if no more data will follow, incomplete headers are skipped.
+     *
+     */
+    size_t scanBlock(const unsigned char *data, size_t size, size_t limit, unsigned long long base, bool final);
+
+    /** \brief Processes a page found in the data.
+     * \param[in] page Page information.
+     *
+     */
+    void onPage(const OGGPage &page);
+
+    StreamCallback             m_callback;     /** found streams callback.                          */
+    PageCallback               m_pageCallback; /** found pages callback.                            */
+    PageCallback               m_pageListener; /** every found page callback.                       */
+    unsigned long long         m_offset;       /** container position after the last given block.   */
+    unsigned long long         m_limit;        /** pages at or after this position are ignored.     */
+    std::vector<unsigned char> m_carry;        /** unscanned bytes of the last block + next ones.   */
+    size_t                     m_carrySize;    /** number of unscanned bytes of the last block.     */
+    unsigned long long         m_position;     /** container position of the next scan.             */
+    bool                       m_pageWalking;  /** true to follow the chain of pages of a stream.   */
+    bool                       m_checksum;     /** true to verify the checksum of the pages.        */
+    bool                       m_walking;      /** true if the next page position is known.         */
+    unsigned long long         m_resume;       /** position to continue the scan after the limit.   */
+    SerialTable                m_streams;      /** beginning positions of the open streams.         */
+};
+
+#endif // OGGSCANNER_H_
@@ -0,0 +1,106 @@
+/*
+ File: PageChecksum.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <PageChecksum.h>
+
+// C++
+#include <array>
+
+namespace
+{
+  const size_t CHECKSUM_POSITION = 22; /** position of the checksum in the page header. */
+
+  using Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+  //----------------------------------------------------------------
+  constexpr Tables generateTables()
+  {
+    Tables tables{};
+
+    for(uint32_t i = 0; i < 256; ++i)
+    {
+      uint32_t value = i << 24;
+      for(int bit = 0; bit < 8; ++bit)
+        value = (value & 0x80000000) ? (value << 1) ^ 0x04c11db7 : (value << 1);
+
+      tables[0][i] = value;
+    }
+
+    // table k gives the checksum of a byte followed by k zero bytes.
+    for(size_t k = 1; k < 8; ++k)
+      for(size_t i = 0; i < 256; ++i)
+        tables[k][i] = (tables[k-1][i] << 8) ^ tables[0][tables[k-1][i] >> 24];
+
+    return tables;
+  }
+
+  constexpr Tables TABLES = generateTables(); /** slicing-by-8 tables. */
+
+  static_assert(TABLES[0][1] == 0x04c11db7, "Wrong checksum table.");
+}
+
+//----------------------------------------------------------------
+uint32_t PageChecksum::update(const unsigned char *data, size_t size, uint32_t crc)
+{
+  while(size >= 8)
+  {
+    const uint32_t high = crc ^ ((static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+                                 (static_cast<uint32_t>(data[2]) << 8)  |  static_cast<uint32_t>(data[3]));
+
+    crc = TABLES[7][high >> 24]         ^ TABLES[6][(high >> 16) & 0xFF] ^
+          TABLES[5][(high >> 8) & 0xFF] ^ TABLES[4][high & 0xFF]         ^
+          TABLES[3][data[4]]            ^ TABLES[2][data[5]]             ^
+          TABLES[1][data[6]]            ^ TABLES[0][data[7]];
+
+    data += 8;
+    size -= 8;
+  }
+
+  while(size-- > 0)
+    crc = (crc << 8) ^ TABLES[0][(crc >> 24) ^ *data++];
+
+  return crc;
+}
+
+//----------------------------------------------------------------
+uint32_t PageChecksum::compute(const unsigned char *page, size_t size)
+{
+  if(size < CHECKSUM_POSITION + 4) return update(page, size);
+
+  const unsigned char zero[4] = { 0, 0, 0, 0 };
+
+  auto crc = update(page, CHECKSUM_POSITION);
+  crc = update(zero, sizeof(zero), crc);
+
+  return update(page + CHECKSUM_POSITION + 4, size - CHECKSUM_POSITION - 4, crc);
+}
+
+//----------------------------------------------------------------
+bool PageChecksum::isValid(const unsigned char *page, size_t size)
+{
+  if(size < CHECKSUM_POSITION + 4) return false;
+
+  const auto stored = static_cast<uint32_t>(page[CHECKSUM_POSITION])             |
+                      (static_cast<uint32_t>(page[CHECKSUM_POSITION + 1]) << 8)  |
+                      (static_cast<uint32_t>(page[CHECKSUM_POSITION + 2]) << 16) |
+                      (static_cast<uint32_t>(page[CHECKSUM_POSITION + 3]) << 24);
+
+  return stored == compute(page, size);
+}
@@ -0,0 +1,58 @@
+/*
+ File: PageChecksum.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAGECHECKSUM_H_
+#define PAGECHECKSUM_H_
+
+// C++
+#include <cstddef>
+#include <cstdint>
+
+/** \brief Ogg page checksum, a CRC32 with the generator polynomial 0x04c11db7, zero
+ *         initial value and no final xor or bit reflection, computed over the whole
+ *         page with the checksum field set to zero. Computed eight bytes at a time
+ *         with tables generated at compile time (slicing-by-8).
+ *
+ */
+namespace PageChecksum
+{
+  /** \brief Returns the checksum of the given data, continuing from the given checksum.
+   * \param[in] data Data pointer.
+   * \param[in] size Data size in bytes.
+   * \param[in] crc Checksum of the previous data.
+   *
+   */
+  uint32_t update(const unsigned char *data, size_t size, uint32_t crc = 0);
+
+  /** \brief Returns the checksum of the given page.
+   * \param[in] page Page data, including header, segment table and body.
+   * \param[in] size Page size in bytes.
+   *
+   */
+  uint32_t compute(const unsigned char *page, size_t size);
+
+  /** \brief Returns true if the checksum stored in the page header matches its contents.
+   * \param[in] page Page data, including header, segment table and body.
+   * \param[in] size Page size in bytes.
+   *
+   */
+  bool isValid(const unsigned char *page, size_t size);
+}
+
+#endif // PAGECHECKSUM_H_
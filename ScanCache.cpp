@@ -0,0 +1,207 @@
+/*
+ File: ScanCache.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <ScanCache.h>
+
+// C++
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+const std::string CACHE_HEADER = "OGGExtractor scan cache 2"; /** first line of the cache files.   */
+const size_t      SAMPLES      = 16;                          /** blocks of the container hashed.  */
+const size_t      SAMPLE_SIZE  = 4096;                        /** size of the hashed blocks.       */
+
+namespace
+{
+  const unsigned long long FNV_OFFSET = 14695981039346656037ULL; /** FNV-1a hash initial value. */
+  const unsigned long long FNV_PRIME  = 1099511628211ULL;        /** FNV-1a hash multiplier.    */
+
+  //----------------------------------------------------------------
+  std::filesystem::path environmentPath(const char *name)
+  {
+    const auto value = std::getenv(name);
+    return (value && value[0] != 0) ? std::filesystem::path(value) : std::filesystem::path();
+  }
+}
+
+//----------------------------------------------------------------
+ScanCache::ScanCache(const std::wstring &container)
+: m_container{container}
+, m_path     {filePath(container, ".cache")}
+, m_size     {0}
+, m_time     {0}
+, m_checksum {false}
+{
+  std::error_code error;
+  m_size = std::filesystem::file_size(std::filesystem::path(container), error);
+  if(error) m_size = 0;
+
+  const auto time = std::filesystem::last_write_time(std::filesystem::path(container), error);
+  if(!error) m_time = time.time_since_epoch().count();
+}
+
+//----------------------------------------------------------------
+bool ScanCache::load(std::vector<OGGData> &streams) const
+{
+  std::ifstream file(m_path, std::ios_base::in);
+  if(!file.is_open() || m_size == 0) return false;
+
+  std::string header;
+  std::getline(file, header);
+  if(header != CACHE_HEADER) return false;
+
+  unsigned long long size = 0, hash = 0;
+  long long time = 0;
+  bool checksum = false;
+  file >> size >> time >> hash >> checksum;
+
+  // the size and time are checked first, the contents only if they match.
+  if(!file || size != m_size || time != m_time || checksum != m_checksum || hash != sampleHash())
+    return false;
+
+  size_t streamsNum = 0;
+  file >> streamsNum;
+
+  std::vector<OGGData> result;
+  for(size_t i = 0; file && i < streamsNum; ++i)
+  {
+    OGGData data;
+    data.container = m_container;
+    file >> data.start >> data.end >> data.hasInfo >> data.channels >> data.rate >> data.duration >> std::quoted(data.error);
+
+    result.push_back(data);
+  }
+
+  if(!file) return false;
+
+  streams = std::move(result);
+  return true;
+}
+
+//----------------------------------------------------------------
+bool ScanCache::save(const std::vector<OGGData> &streams) const
+{
+  if(m_size == 0) return false;
+
+  std::error_code error;
+  std::filesystem::create_directories(m_path.parent_path(), error);
+
+  // written aside and renamed, other instances never read an incomplete file.
+  auto temporal = m_path;
+  temporal += ".tmp";
+
+  {
+    std::ofstream file(temporal, std::ios_base::out|std::ios_base::trunc);
+    if(!file.is_open()) return false;
+
+    file << CACHE_HEADER << "\n";
+    file << m_size << " " << m_time << " " << sampleHash() << " " << m_checksum << "\n";
+    file << streams.size() << "\n";
+
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for(const auto &data: streams)
+    {
+      file << data.start << " " << data.end << " " << data.hasInfo << " " << data.channels << " " << data.rate << " "
+           << data.duration << " " << std::quoted(data.error) << "\n";
+    }
+
+    file.flush();
+    if(!file) return false;
+  }
+
+  std::filesystem::rename(temporal, m_path, error);
+  return !error;
+}
+
+//----------------------------------------------------------------
+unsigned long long ScanCache::sampleHash() const
+{
+  std::ifstream file(std::filesystem::path(m_container), std::ios_base::in|std::ios_base::binary);
+  if(!file.is_open()) return 0;
+
+  // the first and last blocks and the ones evenly spaced between them.
+  std::vector<char> buffer(SAMPLE_SIZE);
+  const auto last = m_size > SAMPLE_SIZE ? m_size - SAMPLE_SIZE : 0;
+
+  unsigned long long hash = FNV_OFFSET;
+  for(size_t i = 0; i < SAMPLES; ++i)
+  {
+    file.seekg(last / (SAMPLES - 1) * i);
+    file.read(buffer.data(), buffer.size());
+
+    const auto read = static_cast<size_t>(file.gcount());
+    for(size_t j = 0; j < read; ++j)
+    {
+      hash ^= static_cast<unsigned char>(buffer[j]);
+      hash *= FNV_PRIME;
+    }
+
+    file.clear();
+  }
+
+  return hash;
+}
+
+//----------------------------------------------------------------
+std::filesystem::path ScanCache::directory()
+{
+#ifdef _WIN32
+  auto base = environmentPath("LOCALAPPDATA");
+#else
+  auto base = environmentPath("XDG_CACHE_HOME");
+  if(base.empty())
+  {
+    base = environmentPath("HOME");
+    if(!base.empty()) base /= ".cache";
+  }
+#endif
+
+  if(base.empty())
+  {
+    std::error_code error;
+    base = std::filesystem::temp_directory_path(error);
+  }
+
+  return base / "OGGExtractor";
+}
+
+//----------------------------------------------------------------
+std::filesystem::path ScanCache::filePath(const std::wstring &container, const std::string &extension)
+{
+  std::error_code error;
+  auto path = std::filesystem::absolute(std::filesystem::path(container), error);
+  if(error) path = std::filesystem::path(container);
+
+  // the files are named after the FNV-1a hash of the container path.
+  unsigned long long hash = FNV_OFFSET;
+  for(const auto character: path.wstring())
+  {
+    hash ^= static_cast<unsigned long long>(character);
+    hash *= FNV_PRIME;
+  }
+
+  std::stringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash << extension;
+
+  return directory() / name.str();
+}
@@ -0,0 +1,98 @@
+/*
+ File: ScanCache.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCANCACHE_H_
+#define SCANCACHE_H_
+
+// Project
+#include <OGGContainerWrapper.h>
+
+// C++
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/** \class ScanCache
+ * \brief Streams found in a container and their information, stored in a file of the user
+ *        cache directory so the container doesn't need to be scanned again. The results are
+ *        only valid for the same container size, modification time and sampled contents, and
+ *        the same scan settings.
+ *
+ */
+class ScanCache
+{
+  public:
+    /** \brief ScanCache class constructor.
+     * \param[in] container Container file name.
+     *
+     */
+    explicit ScanCache(const std::wstring &container);
+
+    /** \brief ScanCache class virtual destructor.
+     *
+     */
+    virtual ~ScanCache()
+    {}
+
+    /** \brief Sets if the checksum of the pages was verified in the scan.
+     * \param[in] value True if verified and false otherwise.
+     *
+     */
+    void setChecksumValidation(const bool value)
+    { m_checksum = value; }
+
+    /** \brief Reads the stored results of the container. Returns false if there are no results or
+     *         the container or the settings have changed.
+     * \param[out] streams Streams of the container, with their information if it was read.
+     *
+     */
+    bool load(std::vector<OGGData> &streams) const;
+
+    /** \brief Stores the results of the container, replacing the previous ones. Returns false on error.
+     * \param[in] streams Streams of the container, with their information if it was read.
+     *
+     */
+    bool save(const std::vector<OGGData> &streams) const;
+
+    /** \brief Returns the directory of the files of the cache, in the cache directory of the user.
+     *
+     */
+    static std::filesystem::path directory();
+
+    /** \brief Returns the name of the file of the cache of the given container with the given extension.
+     * \param[in] container Container file name.
+     * \param[in] extension File extension, with the dot.
+     *
+     */
+    static std::filesystem::path filePath(const std::wstring &container, const std::string &extension);
+
+  private:
+    /** \brief Returns the hash of some blocks of the container spread through all the file.
+     *
+     */
+    unsigned long long sampleHash() const;
+
+    const std::wstring    m_container; /** container file name.                  */
+    std::filesystem::path m_path;      /** cache file name.                      */
+    unsigned long long    m_size;      /** container size in bytes.              */
+    long long             m_time;      /** container modification time.          */
+    bool                  m_checksum;  /** true if the checksums were verified.  */
+};
+
+#endif // SCANCACHE_H_
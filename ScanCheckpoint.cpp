@@ -0,0 +1,138 @@
+/*
+ File: ScanCheckpoint.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <ScanCache.h>
+#include <ScanCheckpoint.h>
+
+// C++
+#include <fstream>
+
+const std::string CHECKPOINT_HEADER = "OGGExtractor checkpoint 1"; /** first line of the checkpoint files. */
+
+//----------------------------------------------------------------
+ScanCheckpoint::ScanCheckpoint(const std::wstring &container)
+: m_path       {ScanCache::filePath(container, ".checkpoint")}
+, m_size       {0}
+, m_time       {0}
+, m_pageWalking{true}
+, m_checksum   {false}
+{
+  std::error_code error;
+  m_size = std::filesystem::file_size(std::filesystem::path(container), error);
+  if(error) m_size = 0;
+
+  const auto time = std::filesystem::last_write_time(std::filesystem::path(container), error);
+  if(!error) m_time = time.time_since_epoch().count();
+}
+
+//----------------------------------------------------------------
+void ScanCheckpoint::setSettings(const bool pageWalking, const bool checksum)
+{
+  m_pageWalking = pageWalking;
+  m_checksum    = checksum;
+}
+
+//----------------------------------------------------------------
+bool ScanCheckpoint::load()
+{
+  std::ifstream file(m_path, std::ios_base::in);
+  if(!file.is_open()) return false;
+
+  std::string header;
+  std::getline(file, header);
+  if(header != CHECKPOINT_HEADER) return false;
+
+  unsigned long long size = 0;
+  long long time = 0;
+  bool pageWalking = false, checksum = false;
+  file >> size >> time >> pageWalking >> checksum;
+
+  // the container or the settings have changed since the checkpoint.
+  if(!file || size != m_size || time != m_time || pageWalking != m_pageWalking || checksum != m_checksum)
+    return false;
+
+  OGGScanner::State state;
+  size_t streamsNum = 0;
+  file >> state.position >> state.walking >> streamsNum;
+  for(size_t i = 0; file && i < streamsNum; ++i)
+  {
+    uint32_t serial = 0;
+    unsigned long long start = 0;
+    file >> serial >> start;
+    state.streams.emplace_back(serial, start);
+  }
+
+  std::vector<std::pair<unsigned long long, unsigned long long>> streams;
+  size_t foundNum = 0;
+  file >> foundNum;
+  for(size_t i = 0; file && i < foundNum; ++i)
+  {
+    unsigned long long start = 0, end = 0;
+    file >> start >> end;
+    streams.emplace_back(start, end);
+  }
+
+  if(!file || state.position > m_size) return false;
+
+  m_state   = std::move(state);
+  m_streams = std::move(streams);
+
+  return true;
+}
+
+//----------------------------------------------------------------
+bool ScanCheckpoint::save() const
+{
+  std::error_code error;
+  std::filesystem::create_directories(m_path.parent_path(), error);
+
+  // written aside and renamed, an interrupted save doesn't lose the previous checkpoint.
+  auto temporal = m_path;
+  temporal += ".tmp";
+
+  {
+    std::ofstream file(temporal, std::ios_base::out|std::ios_base::trunc);
+    if(!file.is_open()) return false;
+
+    file << CHECKPOINT_HEADER << "\n";
+    file << m_size << " " << m_time << " " << m_pageWalking << " " << m_checksum << "\n";
+
+    file << m_state.position << " " << m_state.walking << " " << m_state.streams.size() << "\n";
+    for(const auto &stream: m_state.streams)
+      file << stream.first << " " << stream.second << "\n";
+
+    file << m_streams.size() << "\n";
+    for(const auto &stream: m_streams)
+      file << stream.first << " " << stream.second << "\n";
+
+    file.flush();
+    if(!file) return false;
+  }
+
+  std::filesystem::rename(temporal, m_path, error);
+  return !error;
+}
+
+//----------------------------------------------------------------
+void ScanCheckpoint::remove() const
+{
+  std::error_code error;
+  std::filesystem::remove(m_path, error);
+}
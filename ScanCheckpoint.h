@@ -0,0 +1,112 @@
+/*
+ File: ScanCheckpoint.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCANCHECKPOINT_H_
+#define SCANCHECKPOINT_H_
+
+// Project
+#include <OGGScanner.h>
+
+// C++
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** \class ScanCheckpoint
+ * \brief Progress of an unfinished scan of a container stored next to the scan cache files: the scan state and the streams found before it. A checkpoint is only
+ *        valid for the same container size and modification time and the same scan settings.
+ *
+ */
+class ScanCheckpoint
+{
+  public:
+    /** \brief ScanCheckpoint class constructor.
+     * \param[in] container Container file name.
+     *
+     */
+    explicit ScanCheckpoint(const std::wstring &container);
+
+    /** \brief ScanCheckpoint class virtual destructor.
+     *
+     */
+    virtual ~ScanCheckpoint()
+    {}
+
+    /** \brief Sets the scan settings that change the results of the scan.
+     * \param[in] pageWalking True if the chain of pages is followed.
+     * \param[in] checksum True if the checksum of the pages is verified.
+     *
+     */
+    void setSettings(const bool pageWalking, const bool checksum);
+
+    /** \brief Reads the stored checkpoint of the container. Returns false if there is no checkpoint
+     *         or it doesn't match the container or the settings.
+     *
+     */
+    bool load();
+
+    /** \brief Stores the checkpoint, replacing the previous one. Returns false on error.
+     *
+     */
+    bool save() const;
+
+    /** \brief Removes the stored checkpoint of the container.
+     *
+     */
+    void remove() const;
+
+    /** \brief Returns the state of the scan.
+     *
+     */
+    const OGGScanner::State &state() const
+    { return m_state; }
+
+    /** \brief Sets the state of the scan.
+     * \param[in] state Scan state.
+     *
+     */
+    void setState(const OGGScanner::State &state)
+    { m_state = state; }
+
+    /** \brief Returns the [start, end) ranges of the streams found before the state position.
+     *
+     */
+    const std::vector<std::pair<unsigned long long, unsigned long long>> &streams() const
+    { return m_streams; }
+
+    /** \brief Adds a found stream.
+     * \param[in] start Stream beginning position.
+     * \param[in] end Stream ending position.
+     *
+     */
+    void addStream(unsigned long long start, unsigned long long end)
+    { m_streams.emplace_back(start, end); }
+
+  private:
+    std::filesystem::path                                          m_path;        /** checkpoint file name.                   */
+    unsigned long long                                             m_size;        /** container size in bytes.                */
+    long long                                                      m_time;        /** container modification time.            */
+    bool                                                           m_pageWalking; /** true if the chain of pages is followed. */
+    bool                                                           m_checksum;    /** true if the checksums are verified.     */
+    OGGScanner::State                                              m_state;       /** scan state.                             */
+    std::vector<std::pair<unsigned long long, unsigned long long>> m_streams;     /** streams found before the state.         */
+};
+
+#endif // SCANCHECKPOINT_H_
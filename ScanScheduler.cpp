@@ -0,0 +1,161 @@
+/*
+ File: ScanScheduler.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <ScanScheduler.h>
+#include <ContainerScanner.h>
+
+// C++
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// C
+#include <sys/types.h>
+#include <sys/stat.h>
+
+//----------------------------------------------------------------
+ScanScheduler::ScanScheduler(const std::vector<std::wstring> &containers)
+: m_containers {containers}
+, m_threads    {1}
+, m_readMode   {ReadMode::ASYNC}
+, m_checksum   {false}
+, m_cacheWindow{0}
+, m_checkpoints{false}
+, m_aborted    {false}
+{
+  for(size_t i = 0; i < m_containers.size(); ++i)
+  {
+    std::error_code error;
+    const auto size = std::filesystem::file_size(std::filesystem::path(m_containers.at(i)), error);
+
+    m_info.push_back(Container{i, error ? 0 : size, deviceId(m_containers.at(i))});
+  }
+}
+
+//----------------------------------------------------------------
+unsigned long long ScanScheduler::totalSize() const
+{
+  unsigned long long total = 0;
+  for(const auto &info: m_info)
+    total += info.size;
+
+  return total;
+}
+
+//----------------------------------------------------------------
+bool ScanScheduler::run(StreamCallback callback, ErrorCallback error, ProgressCallback progress)
+{
+  m_aborted = false;
+
+  // one queue per device, a device is read by one thread so the containers are scanned in the given order.
+  std::map<unsigned long long, std::vector<Container>> queues;
+  for(const auto &info: m_info)
+    queues[info.device].push_back(info);
+
+  std::vector<std::atomic<unsigned long long>> processed(m_info.size());
+  for(auto &value: processed) value = 0;
+
+  std::mutex              mutex;
+  std::condition_variable condition;
+  size_t                  finished = 0;
+
+  auto worker = [&](const std::vector<Container> &containers)
+  {
+    for(const auto &info: containers)
+    {
+      if(m_aborted) break;
+
+      auto onStream = [&callback, &info](unsigned long long start, unsigned long long end)
+      {
+        if(callback) callback(info.index, start, end);
+      };
+
+      auto onProgress = [this, &processed, &info](unsigned long long bytes)
+      {
+        processed[info.index] = bytes;
+        return !m_aborted;
+      };
+
+      ContainerScanner scanner(m_containers.at(info.index));
+      scanner.setThreads(m_threads);
+      scanner.setReadMode(m_readMode);
+      scanner.setChecksumValidation(m_checksum);
+      scanner.setCacheWindow(m_cacheWindow);
+      scanner.setCheckpoints(m_checkpoints);
+      scanner.setResume(m_checkpoints);
+
+      if(!scanner.scan(onStream, onProgress) && !scanner.isAborted() && error)
+        error(info.index, scanner.error());
+
+      processed[info.index] = info.size;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++finished;
+    }
+    condition.notify_all();
+  };
+
+  std::vector<std::thread> threads;
+  for(const auto &queue: queues)
+    threads.emplace_back(worker, std::cref(queue.second));
+
+  // roll up the progress of all the containers.
+  bool done = false;
+  while(!done)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait_for(lock, std::chrono::milliseconds(100), [&]() { return finished == threads.size(); });
+      done = (finished == threads.size());
+    }
+
+    unsigned long long total = 0;
+    for(const auto &value: processed)
+      total += value;
+
+    if(progress && !progress(total)) m_aborted = true;
+  }
+
+  for(auto &thread: threads)
+    thread.join();
+
+  return !m_aborted;
+}
+
+//----------------------------------------------------------------
+unsigned long long ScanScheduler::deviceId(const std::wstring &filename)
+{
+#ifdef _WIN32
+  struct _stat64 info;
+  if(0 == _wstat64(filename.c_str(), &info))
+    return static_cast<unsigned long long>(info.st_dev);
+#else
+  struct stat info;
+  if(0 == ::stat(std::filesystem::path(filename).c_str(), &info))
+    return static_cast<unsigned long long>(info.st_dev);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ File: ScanScheduler.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCANSCHEDULER_H_
+#define SCANSCHEDULER_H_
+
+// Project
+#include <BlockReader.h>
+
+// C++
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+/** \class ScanScheduler
+ * \brief Scans several containers at the same time. Containers are grouped by the
+ *        device that stores them and every device gets its own queue, scanned by one
+ *        thread in the given order, so containers on different disks are read in
+ *        parallel without making a disk seek between files.
+ *
+ */
+class ScanScheduler
+{
+  public:
+    /** \brief Function called with the container index and the [start, end) range of every
+     *         found stream. Called concurrently for containers on different devices.
+     *
+     */
+    using StreamCallback = std::function<void(size_t container, unsigned long long start, unsigned long long end)>;
+
+    /** \brief Function called with the container index and the error message of a failed scan.
+     *         Called concurrently for containers on different devices.
+     *
+     */
+    using ErrorCallback = std::function<void(size_t container, const std::string &error)>;
+
+    /** \brief Function called from the calling thread with the number of bytes scanned of all
+     *         the containers. Returns false to abort the scan.
+     *
+     */
+    using ProgressCallback = std::function<bool(unsigned long long processed)>;
+
+    /** \brief ScanScheduler class constructor.
+     * \param[in] containers Container file names.
+     *
+     */
+    explicit ScanScheduler(const std::vector<std::wstring> &containers);
+
+    /** \brief ScanScheduler class virtual destructor.
+     *
+     */
+    virtual ~ScanScheduler()
+    {}
+
+    /** \brief Sets the number of threads used to scan each container.
+     * \param[in] threads Number of threads.
+     *
+     */
+    void setThreads(const unsigned int threads)
+    { m_threads = threads; }
+
+    /** \brief Sets the way the containers are read.
+     * \param[in] mode Read mode.
+     *
+     */
+    void setReadMode(const ReadMode mode)
+    { m_readMode = mode; }
+
+    /** \brief Enables or disables the verification of the checksum of the pages.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setChecksumValidation(const bool value)
+    { m_checksum = value; }
+
+    /** \brief Sets the maximum size of every container in the system cache while scanning.
+     * \param[in] bytes Window size in bytes, 0 for no limit.
+     *
+     */
+    void setCacheWindow(const unsigned long long bytes)
+    { m_cacheWindow = bytes; }
+
+    /** \brief Enables or disables storing the progress of the scans and continuing the scans of
+     *         the containers that were interrupted before.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setCheckpoints(const bool value)
+    { m_checkpoints = value; }
+
+    /** \brief Returns the sum of the sizes of the containers in bytes.
+     *
+     */
+    unsigned long long totalSize() const;
+
+    /** \brief Scans all the containers, returns when all have been scanned or the scan has
+     *         been aborted. Returns false if aborted.
+     * \param[in] callback Function to call for every found stream.
+     * \param[in] error Function to call for every container that couldn't be scanned.
+     * \param[in] progress Function to call with the progress of the scan.
+     *
+     */
+    bool run(StreamCallback callback, ErrorCallback error, ProgressCallback progress = nullptr);
+
+    /** \brief Returns the identifier of the device that stores the given file, or 0 if unknown.
+     * \param[in] filename File name.
+     *
+     */
+    static unsigned long long deviceId(const std::wstring &filename);
+
+  private:
+    /** \struct Container
+     * \brief Scheduling information of a container.
+     *
+     */
+    struct Container
+    {
+      size_t             index;  /** index in the containers list. */
+      unsigned long long size;   /** size in bytes.                */
+      unsigned long long device; /** device identifier.            */
+    };
+
+    const std::vector<std::wstring> m_containers;  /** container file names.                  */
+    std::vector<Container>          m_info;        /** scheduling information of containers.  */
+    unsigned int                    m_threads;     /** number of threads to scan a container. */
+    ReadMode                        m_readMode;    /** containers read mode.                  */
+    bool                            m_checksum;    /** true to verify the checksum of pages.  */
+    unsigned long long              m_cacheWindow; /** system cache window, 0 for no limit.   */
+    bool                            m_checkpoints; /** true to store and resume the scans.    */
+    std::atomic<bool>               m_aborted;     /** true if the scan has been aborted.     */
+};
+
+#endif // SCANSCHEDULER_H_
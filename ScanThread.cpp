@@ -19,17 +19,18 @@
 
 // Project
 #include <OGGExtractor.h>
+#include <CacheHints.h>
+#include <ScanCache.h>
 #include <ScanThread.h>
-
-// Qt
-#include <QFile>
+#include <ScanScheduler.h>
 
 // libvorbis
 #include <vorbis/codec.h>
 #include <vorbis/vorbisfile.h>
 
-const long long BUFFER_SIZE = 5242880; /** 5 MB size buffer.     */
-const char *OGG_HEADER = "OggS";       /** Ogg header signature. */
+// C++
+#include <algorithm>
+#include <iterator>
 
 using namespace OGGWrapper;
 
@@ -40,6 +41,12 @@ ScanThread::ScanThread(const QStringList containers, QObject *parent)
 , m_aborted        {false}
 , m_minimumSize    {-1}
 , m_minimumDuration{0}
+, m_threads        {1}
+, m_readMode       {ReadMode::ASYNC}
+, m_checksum       {false}
+, m_cacheWindow    {0}
+, m_checkpoints    {false}
+, m_streamsNumber  {0}
 {
 }
 
@@ -58,166 +65,129 @@ const std::vector<OGGData> &ScanThread::streams() const
 //--------------------------------------------------------------------
 void ScanThread::run()
 {
-  auto buffer = new char[BUFFER_SIZE];
+  // streams that pass the size and duration filters, the ones without information are checked
+  // when it is read.
+  auto isAccepted = [this](const OGGData &data)
+  {
+    const long long size = data.end - data.start;
+    if(m_minimumSize > 0 && (size < (m_minimumSize * 1024))) return false;
+
+    if(!data.hasInfo) return true;
 
-  unsigned long long int partialSize = 0;
-  unsigned long long int totalSize   = 0;
+    return data.error.empty() && (m_minimumDuration == 0 || data.duration >= m_minimumDuration);
+  };
 
-  for(auto filename: m_containers)
+  // all the streams of every container, the ones with stored results are not scanned again.
+  std::vector<std::vector<OGGData>> found(m_containers.size());
+  std::vector<char> store(m_containers.size(), false);
+  std::vector<std::wstring> containers;
+  std::vector<size_t> indexes;
+  for(int i = 0; i < m_containers.size(); ++i)
   {
-    QFile file(filename);
-    totalSize += file.size();
+    const auto filename = m_containers.at(i).toStdWString();
+
+    ScanCache cache(filename);
+    cache.setChecksumValidation(m_checksum);
+    if(cache.load(found[i]))
+    {
+      m_streamsNumber += std::count_if(found[i].cbegin(), found[i].cend(), isAccepted);
+      continue;
+    }
+
+    containers.push_back(filename);
+    indexes.push_back(i);
   }
 
-  if(totalSize == 0) return;
+  ScanScheduler scheduler(containers);
+  scheduler.setThreads(m_threads);
+  scheduler.setReadMode(m_readMode);
+  scheduler.setChecksumValidation(m_checksum);
+  scheduler.setCacheWindow(m_cacheWindow);
+  scheduler.setCheckpoints(m_checkpoints);
 
-  int progressValue = 0;
-  for(auto filename: m_containers)
+  const auto totalSize = scheduler.totalSize();
+
+  // every container is scanned by only one thread, no need to lock its list. Every stream is
+  // stored, the filters can change the next time.
+  auto addStream = [this, &containers, &indexes, &found, &isAccepted](size_t container, unsigned long long start, unsigned long long end)
   {
-    if(m_aborted) break;
+    OGGData data;
+    data.container = containers.at(container);
+    data.start     = start;
+    data.end       = end;
 
-    QFile file(filename);
-    if(!file.open(QFile::ReadOnly))
-    {
-      auto message = tr("Error opening file '%1'").arg(filename);
-      auto details = tr("Error: %1").arg(file.errorString());
-      emit error(message, details);
-      partialSize += file.size();
+    if(isAccepted(data)) ++m_streamsNumber;
 
-      continue;
-    }
+    found[indexes.at(container)].push_back(data);
+  };
 
-    long long processed             = 0;
-    unsigned long long oggBeginning = 0;
-    unsigned long long oggEnding    = 0;
+  std::vector<char> failed(containers.size(), false);
+  auto onError = [this, &indexes, &failed](size_t container, const std::string &message)
+  {
+    failed[container] = true;
+
+    auto text    = tr("Error scanning file '%1'").arg(m_containers.at(indexes.at(container)));
+    auto details = tr("Error: %1").arg(QString::fromStdString(message));
+    emit error(text, details);
+  };
+
+  int progressValue = 0;
+  auto updateProgress = [this, &totalSize, &progressValue](unsigned long long processed)
+  {
+    const int value = totalSize > 0 ? (100.0*static_cast<double>(processed)/totalSize) : 100;
+    if(value != progressValue)
+    {
+      progressValue = value;
+      emit progress(value);
+    }
 
-    bool beginFound = false;
-    bool endFound   = false;
-    bool eof        = false;
+    return !m_aborted;
+  };
 
-    unsigned char oggHeader[27];
+  if(!containers.empty() && scheduler.run(addStream, onError, updateProgress))
+  {
+    for(size_t i = 0; i < containers.size(); ++i)
+      store[indexes.at(i)] = !failed[i];
+  }
 
-    const auto containerSize = file.size();
+  // the information is read here only if needed by the duration filter, otherwise the interface
+  // reads it in the background.
+  if(m_minimumDuration > 0 && !m_aborted)
+  {
+    // page faults of the mapping read ahead a lot more than the information needs.
+    auto onInfo = [this](const OGGData &data)
+    {
+      if(m_cacheWindow > 0) CacheHints::drop(data.container, data.start, data.end);
+    };
 
-    while (!eof && !m_aborted)
+    for(size_t i = 0; i < found.size(); ++i)
     {
-      const int value = (100.0*static_cast<double>(partialSize)/totalSize);
-      if(value != progressValue)
-      {
-        progressValue = value;
-        emit progress(value);
-      }
-
-      file.seek(processed);
-
-      auto bytesRead = file.read(buffer, BUFFER_SIZE);
-
-      for (long long loop = 0; loop < bytesRead && !eof && !m_aborted; ++loop)
-      {
-        // check for "OggS" header and flags
-        if (buffer[loop] == 0x4F)
-        {
-          auto position   = file.pos();
-          auto seekResult = file.seek(processed + loop);
-          unsigned long long readResult = file.read(reinterpret_cast<char *>(&oggHeader[0]), sizeof(oggHeader));
-          if(!seekResult || (sizeof(oggHeader) != readResult))
-          {
-            auto message = tr("Error scanning file '%1'").arg(filename);
-            auto details = tr("ERROR: %1").arg(file.errorString());
-            emit error(message, details);
-
-            eof = true;
-            continue;
-          }
-          file.seek(position);
-
-          if (0 == (strncmp((const char *) oggHeader, OGG_HEADER, 4)))
-          {
-            // detected beginning of ogg file
-            if (oggHeader[5] & 0x02)
-            {
-              beginFound = true;
-              oggBeginning = processed + loop;
-              continue;
-            }
-
-            // detected ending of ogg file, more difficult because of trailing frames
-            if (beginFound && (oggHeader[5] & 0x04))
-            {
-              endFound = true;
-              oggEnding = processed + loop + sizeof(oggHeader);
-
-              const auto trailingSize = static_cast<size_t>(oggHeader[26]);
-              const auto trailingFrames = new unsigned char[trailingSize];
-
-              position   = file.pos();
-              seekResult = file.seek(oggEnding);
-              readResult = file.read(reinterpret_cast<char *>(trailingFrames), trailingSize);
-
-              if (!seekResult || (trailingSize != readResult))
-              {
-                auto message = tr("I/O error reading input file, probably tried to read past EOF while scanning '%1'").arg(filename);
-                auto details = tr("ERROR: %1").arg(file.errorString());
-                emit error(message, details);
-
-                delete [] trailingFrames;
-
-                eof = true;
-                continue;
-              }
-              file.seek(position);
-
-              oggEnding += trailingSize;
-
-              for (unsigned long i = 0; i < trailingSize; i++)
-              {
-                unsigned char lacingValue = trailingFrames[i];
-                oggEnding += static_cast<unsigned int>(lacingValue);
-              }
-
-              delete [] trailingFrames;
-            }
-
-            if ((beginFound == true) && (endFound == true))
-            {
-              beginFound = endFound = false;
-
-              long long size = oggEnding - oggBeginning;
-              if (m_minimumSize > 0 && (size < (m_minimumSize * 1024)))
-              {
-                // skip file because size
-                continue;
-              }
-
-              OGGData data;
-              data.container = filename.toStdWString();
-              data.start     = oggBeginning;
-              data.end       = oggEnding;
-
-              if(OGGWrapper::oggInfo(data))
-              {
-                const auto time = data.duration;
-                if(m_minimumDuration > 0 && (time < m_minimumDuration))
-                {
-                  // skip file because duration or error
-                  continue;
-                }
-
-                m_streams.push_back(data);
-              }
-            }
-          }
-        }
-      }
-
-      processed += bytesRead;
-      partialSize += bytesRead;
-
-      if (bytesRead < BUFFER_SIZE) eof = true;
+      if(!OGGWrapper::oggInfo(found[i], 0, m_cacheWindow == 0, onInfo)) continue;
+
+      // the kept handles read ahead after the end of the streams.
+      if(m_cacheWindow > 0) CacheHints::drop(m_containers.at(i).toStdWString());
+
+      // the results of failed scans are incomplete.
+      const auto scanned = std::find(indexes.cbegin(), indexes.cend(), i);
+      store[i] = (scanned == indexes.cend()) || store[i];
     }
+
+    m_streamsNumber = 0;
+    for(const auto &streams: found)
+      m_streamsNumber += std::count_if(streams.cbegin(), streams.cend(), isAccepted);
   }
-  
-  emit progress(100);
 
-  delete [] buffer;
+  for(size_t i = 0; i < found.size(); ++i)
+  {
+    if(!store[i]) continue;
+
+    ScanCache cache(m_containers.at(i).toStdWString());
+    cache.setChecksumValidation(m_checksum);
+    cache.save(found[i]);
+  }
+
+  for(auto &streams: found)
+    std::copy_if(streams.cbegin(), streams.cend(), std::back_inserter(m_streams), isAccepted);
+
+  emit progress(100);
 }
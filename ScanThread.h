@@ -21,13 +21,18 @@
 #define SCANTHREAD_H_
 
 // Project
+#include <BlockReader.h>
 #include <OGGContainerWrapper.h>
 
 // Qt
 #include <QThread>
 
+// C++
+#include <atomic>
+
 /** \class ScanThread
- * \brief Thread for scanning containers.
+ * \brief Thread for scanning containers. Containers on different devices are scanned
+ *        at the same time.
  *
  */
 class ScanThread
@@ -66,7 +71,7 @@ class ScanThread
      *
      */
     const int streamsNumber() const
-    { return m_streams.size(); }
+    { return m_streamsNumber; }
 
     /** \brief Sets the minimum stream size to add it to the found list.
      * \param[in] size Stream size in bytes.
@@ -82,6 +87,42 @@ class ScanThread
     void setMinimumStreamDuration(const unsigned int duration)
     { m_minimumDuration = duration; }
 
+    /** \brief Sets the number of threads used to scan each container.
+     * \param[in] threads Number of threads.
+     *
+     */
+    void setThreads(const unsigned int threads)
+    { m_threads = threads; }
+
+    /** \brief Sets the way the containers are read.
+     * \param[in] mode Read mode.
+     *
+     */
+    void setReadMode(const ReadMode mode)
+    { m_readMode = mode; }
+
+    /** \brief Enables or disables the verification of the checksum of the pages.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setChecksumValidation(const bool value)
+    { m_checksum = value; }
+
+    /** \brief Sets the maximum size of every container in the system cache while scanning.
+     * \param[in] bytes Window size in bytes, 0 for no limit.
+     *
+     */
+    void setCacheWindow(const unsigned long long bytes)
+    { m_cacheWindow = bytes; }
+
+    /** \brief Enables or disables storing the progress of the scans and continuing the scans of
+     *         the containers that were interrupted before.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setCheckpoints(const bool value)
+    { m_checkpoints = value; }
+
   signals:
     void progress(int);
     void error(const QString, const QString);
@@ -95,6 +136,12 @@ class ScanThread
       bool                 m_aborted;         /** true if aborted, false otherwise.                 */
       long long            m_minimumSize;     /** minimum file size to add to the found list.       */
       unsigned int         m_minimumDuration; /** minimum stream duration to add to the found list. */
+      unsigned int         m_threads;         /** number of threads to scan each container.         */
+      ReadMode             m_readMode;        /** containers read mode.                             */
+      bool                 m_checksum;        /** true to verify the checksum of the pages.         */
+      unsigned long long   m_cacheWindow;     /** system cache window, 0 for no limit.              */
+      bool                 m_checkpoints;     /** true to store and resume the scans.               */
+      std::atomic<int>     m_streamsNumber;   /** number of streams found while scanning.           */
 
 };
 
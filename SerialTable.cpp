@@ -0,0 +1,147 @@
+/*
+ File: SerialTable.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <SerialTable.h>
+
+const size_t INITIAL_CAPACITY = 16; /** initial number of slots, must be a power of two. */
+
+//----------------------------------------------------------------
+SerialTable::SerialTable()
+: m_entries(INITIAL_CAPACITY, Entry{0, 0, false})
+, m_size   {0}
+{
+}
+
+//----------------------------------------------------------------
+size_t SerialTable::slot(uint32_t serial) const
+{
+  // fibonacci hashing, serials can be consecutive or random.
+  return static_cast<size_t>((serial * 0x9E3779B97F4A7C15ULL) >> 32) & (m_entries.size() - 1);
+}
+
+//----------------------------------------------------------------
+void SerialTable::insert(uint32_t serial, unsigned long long value)
+{
+  // keep the load under 50% so the probe sequences stay short.
+  if(2 * (m_size + 1) > m_entries.size()) grow();
+
+  const auto mask = m_entries.size() - 1;
+  auto position = slot(serial);
+
+  while(m_entries[position].used)
+  {
+    if(m_entries[position].serial == serial)
+    {
+      m_entries[position].value = value;
+      return;
+    }
+
+    position = (position + 1) & mask;
+  }
+
+  m_entries[position] = Entry{value, serial, true};
+  ++m_size;
+}
+
+//----------------------------------------------------------------
+bool SerialTable::take(uint32_t serial, unsigned long long &value)
+{
+  const auto mask = m_entries.size() - 1;
+  auto position = slot(serial);
+
+  while(m_entries[position].used && m_entries[position].serial != serial)
+    position = (position + 1) & mask;
+
+  if(!m_entries[position].used) return false;
+
+  value = m_entries[position].value;
+  --m_size;
+
+  // shift back the following entries of the probe sequence to fill the hole.
+  auto hole = position;
+  auto next = (position + 1) & mask;
+  while(m_entries[next].used)
+  {
+    const auto preferred = slot(m_entries[next].serial);
+
+    // the entry can be moved if its preferred slot is not between the hole and itself.
+    if(((next - preferred) & mask) >= ((next - hole) & mask))
+    {
+      m_entries[hole] = m_entries[next];
+      hole = next;
+    }
+
+    next = (next + 1) & mask;
+  }
+
+  m_entries[hole].used = false;
+
+  return true;
+}
+
+//----------------------------------------------------------------
+bool SerialTable::find(uint32_t serial, unsigned long long &value) const
+{
+  const auto mask = m_entries.size() - 1;
+  auto position = slot(serial);
+
+  while(m_entries[position].used && m_entries[position].serial != serial)
+    position = (position + 1) & mask;
+
+  if(!m_entries[position].used) return false;
+
+  value = m_entries[position].value;
+
+  return true;
+}
+
+//----------------------------------------------------------------
+void SerialTable::clear()
+{
+  m_entries.assign(INITIAL_CAPACITY, Entry{0, 0, false});
+  m_size = 0;
+}
+
+//----------------------------------------------------------------
+std::vector<std::pair<uint32_t, unsigned long long>> SerialTable::entries() const
+{
+  std::vector<std::pair<uint32_t, unsigned long long>> result;
+  result.reserve(m_size);
+
+  for(const auto &entry: m_entries)
+  {
+    if(entry.used) result.emplace_back(entry.serial, entry.value);
+  }
+
+  return result;
+}
+
+//----------------------------------------------------------------
+void SerialTable::grow()
+{
+  std::vector<Entry> entries(2 * m_entries.size(), Entry{0, 0, false});
+  std::swap(entries, m_entries);
+  m_size = 0;
+
+  for(const auto &entry: entries)
+  {
+    if(entry.used) insert(entry.serial, entry.value);
+  }
+}
@@ -0,0 +1,115 @@
+/*
+ File: SerialTable.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERIALTABLE_H_
+#define SERIALTABLE_H_
+
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/** \class SerialTable
+ * \brief Open addressing hash table of the streams that have begun and not ended yet,
+ *        keyed by the serial number of the logical bitstream. Entries are stored in a
+ *        single array with linear probing, usually only a few streams are open at the
+ *        same time.
+ *
+ */
+class SerialTable
+{
+  public:
+    /** \brief SerialTable class constructor.
+     *
+     */
+    SerialTable();
+
+    /** \brief SerialTable class virtual destructor.
+     *
+     */
+    virtual ~SerialTable()
+    {}
+
+    /** \brief Sets the value of the given serial, replacing the previous one if present.
+     * \param[in] serial Bitstream serial number.
+     * \param[in] value Value to store.
+     *
+     */
+    void insert(uint32_t serial, unsigned long long value);
+
+    /** \brief Removes the given serial from the table. Returns true and its value if present
+     *         and false otherwise.
+     * \param[in] serial Bitstream serial number.
+     * \param[out] value Value of the serial, only valid if the result is true.
+     *
+     */
+    bool take(uint32_t serial, unsigned long long &value);
+
+    /** \brief Returns true and the value of the given serial if present and false otherwise.
+     * \param[in] serial Bitstream serial number.
+     * \param[out] value Value of the serial, only valid if the result is true.
+     *
+     */
+    bool find(uint32_t serial, unsigned long long &value) const;
+
+    /** \brief Returns the number of serials in the table.
+     *
+     */
+    size_t size() const
+    { return m_size; }
+
+    /** \brief Removes all the serials from the table.
+     *
+     */
+    void clear();
+
+    /** \brief Returns the serials in the table and their values, in no particular order.
+     *
+     */
+    std::vector<std::pair<uint32_t, unsigned long long>> entries() const;
+
+  private:
+    /** \struct Entry
+     * \brief Table slot.
+     *
+     */
+    struct Entry
+    {
+      unsigned long long value;  /** stored value.                   */
+      uint32_t           serial; /** bitstream serial number.        */
+      bool               used;   /** true if the slot has a serial.  */
+    };
+
+    /** \brief Returns the preferred slot of the given serial.
+     * \param[in] serial Bitstream serial number.
+     *
+     */
+    size_t slot(uint32_t serial) const;
+
+    /** \brief Doubles the capacity of the table.
+     *
+     */
+    void grow();
+
+    std::vector<Entry> m_entries; /** table slots, power of two size. */
+    size_t             m_size;    /** number of used slots.           */
+};
+
+#endif // SERIALTABLE_H_
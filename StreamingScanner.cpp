@@ -0,0 +1,139 @@
+/*
+ File: StreamingScanner.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <StreamingScanner.h>
+
+// C++
+#include <algorithm>
+
+//----------------------------------------------------------------
+StreamingScanner::StreamingScanner(DataCallback callback, unsigned long long bufferSize)
+: m_callback  {callback}
+, m_bufferSize{bufferSize}
+, m_scanner   {[this](unsigned long long start, unsigned long long end) { m_found.emplace_back(start, end); }}
+, m_skip      {0}
+, m_base      {0}
+{
+  m_scanner.setPageListener([this](const OGGPage &page) { onPage(page); });
+}
+
+//----------------------------------------------------------------
+void StreamingScanner::scan(const unsigned char *data, size_t size)
+{
+  if(size == 0) return;
+
+  // the ending page of a stream is found before its body is read.
+  m_buffer.insert(m_buffer.end(), data, data + size);
+  m_scanner.scan(data, size);
+
+  deliver();
+  discard();
+}
+
+//----------------------------------------------------------------
+void StreamingScanner::finish()
+{
+  m_scanner.finish();
+  deliver();
+
+  // the container ended before them.
+  for(const auto &range: m_found)
+    if(m_callback) m_callback(range.first, range.second, nullptr);
+
+  m_found.clear();
+  m_pages.clear();
+  std::vector<unsigned char>().swap(m_buffer);
+  m_skip = 0;
+  m_base = processed();
+}
+
+//----------------------------------------------------------------
+void StreamingScanner::deliver()
+{
+  const auto end = processed();
+
+  auto it = m_found.begin();
+  while(it != m_found.end())
+  {
+    if(it->second > end)
+    {
+      ++it;
+      continue;
+    }
+
+    const unsigned char *data = nullptr;
+    if(it->first >= m_base) data = m_buffer.data() + m_skip + (it->first - m_base);
+
+    if(m_callback) m_callback(it->first, it->second, data);
+
+    it = m_found.erase(it);
+  }
+}
+
+//----------------------------------------------------------------
+void StreamingScanner::discard()
+{
+  // the data is needed from the beginning of the oldest stream, open or found, or from the
+  // position where the scanner can find a new one.
+  const auto state = m_scanner.state();
+  auto keep = std::min(state.position, processed());
+  for(const auto &stream: state.streams)
+  {
+    // a stream without recent pages was truncated or its beginning was a false positive.
+    unsigned long long last = 0;
+    if(m_pages.find(stream.first, last) && processed() > last + MAX_PAGE_GAP) continue;
+
+    keep = std::min(keep, stream.second);
+  }
+  for(const auto &range: m_found)
+    keep = std::min(keep, range.first);
+
+  // the oldest streams are lost if there's not enough room.
+  if(processed() - keep > m_bufferSize) keep = processed() - m_bufferSize;
+
+  if(keep <= m_base) return;
+
+  m_skip += static_cast<size_t>(keep - m_base);
+  m_base = keep;
+
+  // the discarded data is removed when it's the biggest part of the buffer, and its memory is
+  // released when the buffer has grown much bigger than the kept data.
+  if(m_skip > m_buffer.size() / 2)
+  {
+    m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_skip);
+    m_skip = 0;
+
+    if(m_buffer.capacity() > 4 * m_buffer.size()) m_buffer.shrink_to_fit();
+  }
+}
+
+//----------------------------------------------------------------
+void StreamingScanner::onPage(const OGGPage &page)
+{
+  const auto end = page.offset + page.size;
+
+  unsigned long long last = 0;
+  if(page.flags & 0x02)
+    m_pages.insert(page.serial, end);
+  else if(page.flags & 0x04)
+    m_pages.take(page.serial, last);
+  else if(m_pages.find(page.serial, last))
+    m_pages.insert(page.serial, end);
+}
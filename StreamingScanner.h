@@ -0,0 +1,127 @@
+/*
+ File: StreamingScanner.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STREAMINGSCANNER_H_
+#define STREAMINGSCANNER_H_
+
+// Project
+#include <OGGScanner.h>
+
+// C++
+#include <functional>
+#include <utility>
+#include <vector>
+
+/** \class StreamingScanner
+ * \brief Finds the OGG streams of a container that can only be read once and forward, like a
+ *        pipe, and gives their data as soon as it has been read. Only the data from the beginning
+ *        of the oldest open stream is kept, up to a maximum size. Open streams without pages in
+ *        the last MAX_PAGE_GAP bytes are considered truncated and don't keep data.
+ *
+ */
+class StreamingScanner
+{
+  public:
+    /** \brief Function called with the [start, end) range of every found stream and its data, or
+     *         nullptr if the data was discarded because it didn't fit in the buffer or the container
+     *         ended before the stream. The data is only valid during the call.
+     *
+     */
+    using DataCallback = std::function<void(unsigned long long start, unsigned long long end, const unsigned char *data)>;
+
+    static constexpr unsigned long long DEFAULT_BUFFER_SIZE = 1073741824; /** default maximum size of the kept data.         */
+    static constexpr unsigned long long MAX_PAGE_GAP        = 16777216;   /** maximum distance between pages of a stream.   */
+
+    /** \brief StreamingScanner class constructor.
+     * \param[in] callback Function to call for every found stream.
+     * \param[in] bufferSize Maximum size of the kept data.
+     *
+     */
+    explicit StreamingScanner(DataCallback callback, unsigned long long bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /** \brief StreamingScanner class virtual destructor.
+     *
+     */
+    virtual ~StreamingScanner()
+    {}
+
+    /** \brief Enables or disables the verification of the checksum of the pages. Disabled by
+     *         default. Must be set before scanning.
+     * \param[in] value True to enable and false otherwise.
+     *
+     */
+    void setChecksumValidation(const bool value)
+    { m_scanner.setChecksumValidation(value); }
+
+    /** \brief Scans the given block, the found streams which data has been read are given to the
+     *         callback. Blocks must be given in order and without gaps.
+     * \param[in] data Block data.
+     * \param[in] size Block size in bytes.
+     *
+     */
+    void scan(const unsigned char *data, size_t size);
+
+    /** \brief Scans the bytes kept from the last block and gives the incomplete streams to the
+     *         callback. Must be called once after the last block.
+     *
+     */
+    void finish();
+
+    /** \brief Returns the number of bytes given to the scanner.
+     *
+     */
+    unsigned long long processed() const
+    { return m_scanner.processed(); }
+
+    /** \brief Returns the number of bytes kept.
+     *
+     */
+    unsigned long long buffered() const
+    { return m_buffer.size() - m_skip; }
+
+  private:
+    /** \brief Gives the found streams which data has been read to the callback.
+     *
+     */
+    void deliver();
+
+    /** \brief Discards the kept data that can't be part of a stream anymore.
+     *
+     */
+    void discard();
+
+    /** \brief Updates the position of the last page of the open streams with the given page.
+     * \param[in] page Page information.
+     *
+     */
+    void onPage(const OGGPage &page);
+
+    using Range = std::pair<unsigned long long, unsigned long long>;
+
+    DataCallback               m_callback;   /** found streams callback.                             */
+    unsigned long long         m_bufferSize; /** maximum size of the kept data.                      */
+    OGGScanner                 m_scanner;    /** pages scanner.                                      */
+    std::vector<unsigned char> m_buffer;     /** kept data, the first m_skip bytes are discarded.    */
+    size_t                     m_skip;       /** discarded bytes at the beginning of the buffer.     */
+    unsigned long long         m_base;       /** container position of the first kept byte.          */
+    std::vector<Range>         m_found;      /** found streams which data hasn't been read yet.      */
+    SerialTable                m_pages;      /** end of the last page of the open streams.           */
+};
+
+#endif // STREAMINGSCANNER_H_
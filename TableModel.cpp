@@ -78,6 +78,17 @@ void TableModel::clearModel()
   endResetModel();
 }
 
+//----------------------------------------------------------------------------
+void TableModel::updateRow(const unsigned int index)
+{
+  const auto first = m_page * m_pageSize;
+  if(m_data && index >= first && index < first + pageItems())
+  {
+    const auto row = static_cast<int>(index - first);
+    emit dataChanged(createIndex(row, 2, nullptr), createIndex(row, 7, nullptr), {Qt::DisplayRole});
+  }
+}
+
 //----------------------------------------------------------------------------
 QVariant TableModel::data(const QModelIndex &index, int role) const
 {
@@ -205,6 +216,10 @@ void TableModel::updateTableContents()
 //----------------------------------------------------------------------------
 QVariant TableModel::dataDisplayRole(const OGGData &data, int column) const
 {
+  // the information of the stream is read in the background.
+  if(!data.hasInfo && (column == 2 || column == 3 || column == 4 || column == 7))
+    return QString("...");
+
   switch (column)
   {
     case 1: // Filename
@@ -112,6 +112,12 @@ class TableModel
      */
     void clearModel();
 
+    /** \brief Updates the table row of the given item if it's in the current page.
+     * \param[in] index Index of the item in the model data.
+     *
+     */
+    void updateRow(const unsigned int index);
+
     // Reimplemented from base class.
     virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
     virtual bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
@@ -0,0 +1,285 @@
+/*
+ File: TarArchive.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <FileHandle.h>
+#include <TarArchive.h>
+
+// C++
+#include <algorithm>
+#include <array>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+namespace
+{
+  const size_t             BLOCK_SIZE       = 512;          /** size of the tar blocks.                      */
+  const size_t             NAME_SIZE        = 100;          /** size of the name field of the header.        */
+  const unsigned long long MAX_OCTAL_SIZE   = 077777777777; /** biggest size of the size field of the header. */
+  const size_t             COPY_BUFFER_SIZE = 1048576;      /** buffer size of the copy of the data.          */
+
+  using Header = std::array<char, BLOCK_SIZE>;
+
+  //----------------------------------------------------------------
+  unsigned long long padded(const unsigned long long size)
+  {
+    return (size + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+  }
+
+  /** \brief Returns the records of the extended header of the member, empty if it doesn't need one.
+   * \param[in] name Member name.
+   * \param[in] size Member size.
+   *
+   */
+  std::string extendedRecords(const std::string &name, const unsigned long long size)
+  {
+    // every record starts with its own length.
+    auto record = [](const std::string &key, const std::string &value)
+    {
+      const auto text = " " + key + "=" + value + "\n";
+      auto length = text.size() + 1;
+      while(std::to_string(length).size() + text.size() != length) ++length;
+
+      return std::to_string(length) + text;
+    };
+
+    std::string records;
+    if(name.size() > NAME_SIZE) records += record("path", name);
+    if(size > MAX_OCTAL_SIZE)   records += record("size", std::to_string(size));
+
+    return records;
+  }
+
+  /** \brief Returns the size of the member in the archive, with its headers and padding.
+   * \param[in] name Member name.
+   * \param[in] size Member size.
+   *
+   */
+  unsigned long long memberSize(const std::string &name, const unsigned long long size)
+  {
+    const auto records = extendedRecords(name, size);
+    const auto extended = records.empty() ? 0 : BLOCK_SIZE + padded(records.size());
+
+    return extended + BLOCK_SIZE + padded(size);
+  }
+
+  //----------------------------------------------------------------
+  void writeOctal(char *field, const size_t width, unsigned long long value)
+  {
+    field[width - 1] = '\0';
+    for(size_t i = width - 1; i > 0; --i, value >>= 3)
+      field[i - 1] = '0' + (value & 7);
+  }
+
+  /** \brief Returns the ustar header of a member.
+   * \param[in] name Member name, truncated if too long.
+   * \param[in] size Member size, 0 if too big.
+   * \param[in] type Member type flag.
+   *
+   */
+  Header header(const std::string &name, const unsigned long long size, const char type)
+  {
+    Header block{};
+    std::copy_n(name.cbegin(), std::min(name.size(), NAME_SIZE), block.begin());
+
+    writeOctal(&block[100], 8, 0644);
+    writeOctal(&block[108], 8, 0);
+    writeOctal(&block[116], 8, 0);
+    writeOctal(&block[124], 12, size > MAX_OCTAL_SIZE ? 0 : size);
+    writeOctal(&block[136], 12, static_cast<unsigned long long>(std::time(nullptr)));
+    block[156] = type;
+    std::copy_n("ustar\0" "00", 8, &block[257]);
+
+    // the checksum is computed with its own field filled with spaces.
+    std::fill_n(&block[148], 8, ' ');
+    unsigned int checksum = 0;
+    for(const auto value: block)
+      checksum += static_cast<unsigned char>(value);
+
+    writeOctal(&block[148], 7, checksum);
+    block[155] = ' ';
+
+    return block;
+  }
+
+  //----------------------------------------------------------------
+  std::string quoted(const std::string &text)
+  {
+    if(text.find_first_of(",\"\n") == std::string::npos) return text;
+
+    std::string result = "\"";
+    for(const auto c: text)
+    {
+      if(c == '"') result += '"';
+      result += c;
+    }
+
+    return result + "\"";
+  }
+
+  /** \brief Returns the contents of the index for the given members, which data starts at the given position.
+   * \param[in] members Archive members.
+   * \param[in] position Position of the first member in the archive.
+   *
+   */
+  std::string indexAt(const std::vector<TarArchive::Member> &members, unsigned long long position)
+  {
+    std::string index = "name,offset,size\n";
+    for(const auto &member: members)
+    {
+      const auto size = member.end > member.begin ? member.end - member.begin : 0;
+      const auto total = memberSize(member.name, size);
+
+      // the data is after the headers.
+      index += quoted(member.name) + "," + std::to_string(position + total - padded(size)) + "," + std::to_string(size) + "\n";
+      position += total;
+    }
+
+    return index;
+  }
+}
+
+//----------------------------------------------------------------
+std::string TarArchive::index(const std::vector<Member> &members)
+{
+  // the positions of the members depend on the size of the index.
+  std::string index;
+  unsigned long long first = 0;
+  do
+  {
+    first = memberSize(INDEX_NAME, index.size());
+    index = indexAt(members, first);
+  }
+  while(memberSize(INDEX_NAME, index.size()) != first);
+
+  return index;
+}
+
+//----------------------------------------------------------------
+bool TarArchive::write(const std::wstring &archive, const std::vector<Member> &members, std::string &error,
+                       FileCopy::RangeCallback finished, FileCopy::ProgressCallback progress, const bool flush)
+{
+  error.clear();
+
+  std::ofstream output(std::filesystem::path(archive), std::ios_base::out|std::ios_base::binary|std::ios_base::trunc);
+  if(!output.is_open())
+  {
+    error = "Unable to create the archive file.";
+    return false;
+  }
+
+  auto fail = [&output, &archive, &error](const std::string &message)
+  {
+    output.close();
+
+    std::error_code removeError;
+    std::filesystem::remove(std::filesystem::path(archive), removeError);
+    error = message;
+
+    return false;
+  };
+
+  auto writeHeaders = [&output](const std::string &name, const unsigned long long size)
+  {
+    const auto records = extendedRecords(name, size);
+    if(!records.empty())
+    {
+      const auto extended = header("././@PaxHeader", records.size(), 'x');
+      output.write(extended.data(), extended.size());
+      output.write(records.data(), records.size());
+      output.write(Header{}.data(), padded(records.size()) - records.size());
+    }
+
+    const auto block = header(name, size, '0');
+    output.write(block.data(), block.size());
+  };
+
+  const auto contents = index(members);
+
+  // the size of the archive is known before writing it.
+  auto archiveSize = memberSize(INDEX_NAME, contents.size()) + 2 * BLOCK_SIZE;
+  for(const auto &member: members)
+    archiveSize += memberSize(member.name, member.end > member.begin ? member.end - member.begin : 0);
+
+  FileCopy::preallocate(archive, archiveSize);
+
+  writeHeaders(INDEX_NAME, contents.size());
+  output.write(contents.data(), contents.size());
+  output.write(Header{}.data(), padded(contents.size()) - contents.size());
+
+  std::vector<char> buffer;
+  std::shared_ptr<FileHandle> input;
+  unsigned long long done = 0;
+  for(size_t i = 0; i < members.size() && output; ++i)
+  {
+    const auto &member = members.at(i);
+    const auto size = member.end > member.begin ? member.end - member.begin : 0;
+
+    writeHeaders(member.name, size);
+
+    // the handle is kept while the source doesn't change.
+    std::string message;
+    if(!input || i == 0 || members.at(i - 1).source != member.source) input = FileHandle::open(member.source);
+    if(!input) message = "Unable to open the source file.";
+
+    unsigned long long written = 0;
+    while(written < size && output)
+    {
+      const auto count = static_cast<size_t>(std::min<unsigned long long>(size - written, COPY_BUFFER_SIZE));
+      if(buffer.size() < count) buffer.resize(count);
+
+      // the positions in the index must be kept even if the data can't be read.
+      size_t valid = 0;
+      if(message.empty())
+      {
+        const auto bytesRead = input->read(reinterpret_cast<unsigned char *>(buffer.data()), count, member.begin + written);
+        if(bytesRead != static_cast<long long>(count))
+          message = bytesRead < 0 ? "Error reading the source file." : "Unexpected end of the source file.";
+
+        valid = static_cast<size_t>(std::max(0LL, bytesRead));
+      }
+
+      std::fill(buffer.begin() + valid, buffer.begin() + count, 0);
+
+      output.write(buffer.data(), count);
+      written += count;
+      done += count;
+
+      if(progress && !progress(done)) return fail("Copy cancelled.");
+    }
+
+    output.write(Header{}.data(), padded(size) - size);
+
+    if(output && finished) finished(i, message);
+  }
+
+  // the end of the archive is marked with two empty blocks.
+  output.write(Header{}.data(), BLOCK_SIZE);
+  output.write(Header{}.data(), BLOCK_SIZE);
+  output.close();
+
+  if(output.fail()) return fail("Error writing the archive file.");
+
+  // the archive is complete even if it couldn't be flushed, the error is reported anyway.
+  if(flush) FileCopy::flush(archive, error);
+
+  return true;
+}
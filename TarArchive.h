@@ -0,0 +1,77 @@
+/*
+ File: TarArchive.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TARARCHIVE_H_
+#define TARARCHIVE_H_
+
+// Project
+#include <FileCopy.h>
+
+// C++
+#include <string>
+#include <vector>
+
+/** \brief Writes ranges of files as the members of an uncompressed tar archive in one sequential
+ *         write. The first member of the archive is an index with the position and size of the
+ *         data of the rest, so they can be read directly without unpacking the archive.
+ *
+ */
+namespace TarArchive
+{
+  const std::string INDEX_NAME = "index.csv"; /** name of the index member. */
+
+  /** \struct Member
+   * \brief Member of the archive with the data of a range of a file.
+   *
+   */
+  struct Member
+  {
+    std::string        name;   /** name of the member in the archive, UTF-8. */
+    std::wstring       source; /** source file name.                         */
+    unsigned long long begin;  /** start of the range in the source file.    */
+    unsigned long long end;    /** end of the range in the source file.      */
+  };
+
+  /** \brief Returns the contents of the index of the given members, a CSV with the name, the position
+   *         of the data in the archive and the size of every member.
+   * \param[in] members Archive members.
+   *
+   */
+  std::string index(const std::vector<Member> &members);
+
+  /** \brief Creates or truncates the archive and writes the index and the given members to it. Returns
+   *         true if the archive was written, even if the data of some members couldn't be read or it couldn't
+   *         be flushed, and false otherwise.
+   * \param[in] archive Archive file name.
+   * \param[in] members Archive members.
+   * \param[out] error Error message if the archive can't be written, is cancelled or can't be flushed, the errors
+   *                   of the members are given to the callback.
+   * \param[in] finished Callback called when the data of every member has been written or nullptr. The data of
+   *                     the members that couldn't be read is filled with zeros to keep the positions of the index.
+   * \param[in] progress Progress callback with the number of bytes of the members written or nullptr. The archive
+   *                     is removed if cancelled.
+   * \param[in] flush True to flush the archive to the disk before returning.
+   *
+   */
+  bool write(const std::wstring &archive, const std::vector<Member> &members, std::string &error,
+             FileCopy::RangeCallback finished = nullptr, FileCopy::ProgressCallback progress = nullptr,
+             const bool flush = false);
+}
+
+#endif // TARARCHIVE_H_
@@ -0,0 +1,368 @@
+/*
+ File: VorbisProbe.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <PageChecksum.h>
+#include <VorbisProbe.h>
+
+// C++
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace OGGWrapper;
+
+namespace
+{
+  const size_t HEADER_SIZE   = 27;                            /** fixed part of the page header.                    */
+  const size_t MAX_PAGE_SIZE = HEADER_SIZE + 255 + 255 * 255; /** biggest page with header and body.                */
+  const size_t TAIL_SIZE     = 8192;                          /** first size read at the end to find the last page. */
+
+  /** \struct Page
+   * \brief Ogg page read from the stream.
+   *
+   */
+  struct Page
+  {
+    std::vector<unsigned char> data;     /** header, segment table and body.       */
+    uint32_t                   serial;   /** serial number of the bitstream.       */
+    uint32_t                   sequence; /** page sequence number.                 */
+    int64_t                    granule;  /** granule position, -1 if none.         */
+    unsigned char              flags;    /** header type flags.                    */
+    size_t                     segments; /** number of segments of the body.       */
+
+    Page(): serial{0}, sequence{0}, granule{-1}, flags{0}, segments{0} {};
+  };
+
+  /** \class BitReader
+   * \brief Reads the bits of a Vorbis packet from its end towards its beginning, the fields
+   *        of the packet read this way have their bits in the usual order.
+   *
+   */
+  class BitReader
+  {
+    public:
+      /** \brief BitReader class constructor.
+       * \param[in] data Packet data.
+       * \param[in] size Packet size in bytes.
+       *
+       */
+      BitReader(const unsigned char *data, size_t size)
+      : m_data{data}
+      , m_bit {static_cast<long long>(size) * 8 - 1}
+      {}
+
+      /** \brief Returns the number of bits left to read.
+       *
+       */
+      long long left() const
+      { return m_bit + 1; }
+
+      /** \brief Returns the value of the given number of bits read backwards. There must be enough bits left.
+       * \param[in] bits Number of bits.
+       *
+       */
+      unsigned int read(const unsigned int bits)
+      {
+        unsigned int value = 0;
+        for(unsigned int i = 0; i < bits; ++i, --m_bit)
+          value = (value << 1) | ((m_data[m_bit / 8] >> (m_bit % 8)) & 1);
+
+        return value;
+      }
+
+      /** \brief Skips the given number of bits.
+       * \param[in] bits Number of bits.
+       *
+       */
+      void skip(const long long bits)
+      { m_bit -= bits; }
+
+    private:
+      const unsigned char *m_data; /** packet data.                   */
+      long long            m_bit;  /** index of the next bit to read. */
+  };
+
+  //----------------------------------------------------------------
+  uint32_t read32(const unsigned char *data)
+  {
+    return static_cast<uint32_t>(data[0])         | (static_cast<uint32_t>(data[1]) << 8) |
+          (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+  }
+
+  //----------------------------------------------------------------
+  bool isHeader(const std::vector<unsigned char> &packet, const unsigned char type)
+  {
+    return packet.size() >= 7 && packet[0] == type && 0 == std::memcmp(&packet[1], "vorbis", 6);
+  }
+
+  //----------------------------------------------------------------
+  size_t pageSize(const unsigned char *data, size_t available)
+  {
+    if(available < HEADER_SIZE || 0 != std::memcmp(data, "OggS", 4) || data[4] != 0) return 0;
+
+    const size_t segments = data[26];
+    if(available < HEADER_SIZE + segments) return 0;
+
+    size_t size = HEADER_SIZE + segments;
+    for(size_t i = 0; i < segments; ++i)
+      size += data[HEADER_SIZE + i];
+
+    if(available < size || !PageChecksum::isValid(data, size)) return 0;
+
+    return size;
+  }
+
+  //----------------------------------------------------------------
+  void fillPage(Page &page)
+  {
+    const auto data = page.data.data();
+
+    page.flags    = data[5];
+    page.granule  = static_cast<int64_t>(static_cast<uint64_t>(read32(&data[6])) | (static_cast<uint64_t>(read32(&data[10])) << 32));
+    page.serial   = read32(&data[14]);
+    page.sequence = read32(&data[18]);
+    page.segments = data[26];
+  }
+
+  //----------------------------------------------------------------
+  bool readPage(OGGContainerWrapper &wrapper, unsigned long long offset, unsigned long long size, Page &page)
+  {
+    if(offset + HEADER_SIZE > size) return false;
+
+    page.data.resize(HEADER_SIZE);
+    wrapper.seek(offset, SEEK_SET);
+    if(wrapper.read(page.data.data(), 1, HEADER_SIZE) != HEADER_SIZE) return false;
+
+    const size_t segments = page.data[26];
+    page.data.resize(HEADER_SIZE + segments);
+    if(offset + page.data.size() > size) return false;
+    if(segments > 0 && wrapper.read(&page.data[HEADER_SIZE], 1, segments) != segments) return false;
+
+    size_t bodySize = 0;
+    for(size_t i = 0; i < segments; ++i)
+      bodySize += page.data[HEADER_SIZE + i];
+
+    page.data.resize(HEADER_SIZE + segments + bodySize);
+    if(offset + page.data.size() > size) return false;
+    if(bodySize > 0 && wrapper.read(&page.data[HEADER_SIZE + segments], 1, bodySize) != bodySize) return false;
+
+    if(pageSize(page.data.data(), page.data.size()) != page.data.size()) return false;
+
+    fillPage(page);
+
+    return true;
+  }
+
+  //----------------------------------------------------------------
+  bool readLastPage(OGGContainerWrapper &wrapper, unsigned long long size, Page &page)
+  {
+    std::vector<unsigned char> buffer;
+
+    // the last page is usually small, the biggest one fits in the second read.
+    for(auto tailSize: {TAIL_SIZE, MAX_PAGE_SIZE})
+    {
+      const auto readSize = static_cast<size_t>(std::min<unsigned long long>(tailSize, size));
+      buffer.resize(readSize);
+      wrapper.seek(size - readSize, SEEK_SET);
+      if(wrapper.read(buffer.data(), 1, readSize) != readSize) return false;
+
+      // the pages are found going forward, as inside the pages there can be false captures.
+      size_t last = readSize;
+      for(size_t i = 0; i < readSize;)
+      {
+        const auto found = pageSize(&buffer[i], readSize - i);
+        if(found == 0)
+        {
+          ++i;
+          continue;
+        }
+
+        if(i + found == readSize) last = i;
+        i += found;
+      }
+
+      if(last != readSize)
+      {
+        page.data.assign(buffer.begin() + last, buffer.end());
+        fillPage(page);
+        return true;
+      }
+
+      if(readSize == size) break;
+    }
+
+    return false;
+  }
+}
+
+//----------------------------------------------------------------
+bool VorbisProbe::probe(OGGData &data, OGGContainerWrapper &wrapper)
+{
+  const auto size = data.end - data.start;
+
+  Page page;
+  if(!readPage(wrapper, 0, size, page) || !(page.flags & 0x02)) return false;
+
+  const auto serial = page.serial;
+  auto sequence     = page.sequence;
+
+  int channels = 0;
+  long rate = 0;
+  long blockSizes[2] = {0, 0};
+  std::vector<char> blockFlags;
+  int modeBits = 0;
+
+  int headers = 0;
+  bool audio = false;
+  long long accumulated = 0;
+  long lastBlock = -1;
+
+  std::vector<unsigned char> packet;
+  unsigned long long offset = 0;
+  while(true)
+  {
+    if(offset > 0)
+    {
+      if(!readPage(wrapper, offset, size, page)) return false;
+
+      // other bitstreams, new streams or missing pages are left to libvorbis.
+      if(page.serial != serial || (page.flags & 0x02) || page.sequence != ++sequence) return false;
+    }
+    offset += page.data.size();
+
+    // packets continued from the previous page must have started there.
+    if(((page.flags & 0x01) != 0) != !packet.empty()) return false;
+
+    const unsigned char *body = &page.data[HEADER_SIZE + page.segments];
+    for(size_t i = 0; i < page.segments; ++i)
+    {
+      const auto lacing = page.data[HEADER_SIZE + i];
+      packet.insert(packet.end(), body, body + lacing);
+      body += lacing;
+
+      if(lacing == 255) continue;
+
+      if(audio)
+      {
+        // as vorbis_packet_blocksize(), the packets that are not audio are ignored.
+        if(!packet.empty() && (packet[0] & 1) == 0)
+        {
+          // the mode follows the packet type bit, in the first byte with two modes at most.
+          const unsigned int mode = (packet[0] >> 1) & ((1 << modeBits) - 1);
+
+          const long thisBlock = blockSizes[static_cast<int>(blockFlags.at(mode))];
+          if(lastBlock != -1) accumulated += (lastBlock + thisBlock) >> 2;
+          lastBlock = thisBlock;
+        }
+      }
+      else
+      {
+        switch(headers)
+        {
+          case 0:
+            if(!isHeader(packet, 1) || packet.size() < 30 || read32(&packet[7]) != 0 || !(packet[29] & 1)) return false;
+            channels      = packet[11];
+            rate          = static_cast<long>(read32(&packet[12]));
+            blockSizes[0] = 1L << (packet[28] & 0x0F);
+            blockSizes[1] = 1L << (packet[28] >> 4);
+            if(channels < 1 || rate < 1 || blockSizes[0] < 64 || blockSizes[1] < blockSizes[0] || blockSizes[1] > 8192) return false;
+
+            // the identification header is alone in the first page.
+            if(i + 1 != page.segments) return false;
+            break;
+          case 1:
+            if(!isHeader(packet, 3)) return false;
+            break;
+          case 2:
+            {
+              if(!isHeader(packet, 5)) return false;
+
+              // the modes are the last field of the setup header, before the framing bit. Their
+              // count is found going backwards while the fields of a mode are valid, as FFmpeg does.
+              BitReader reader(packet.data(), packet.size());
+              bool framing = false;
+              while(!framing && reader.left() > 97)
+                framing = (reader.read(1) == 1);
+
+              const auto modesEnd = reader.left();
+              int modes = 0;
+              int count = 0;
+              while(reader.left() >= 97)
+              {
+                if(reader.read(8) > 63 || reader.read(16) != 0 || reader.read(16) != 0) break;
+                reader.read(1);
+
+                if(++count > 64) break;
+
+                auto countReader = reader;
+                if(static_cast<int>(countReader.read(6)) + 1 == count) modes = count;
+              }
+
+              // libvorbis encoders use two modes, more are probably false matches.
+              if(!framing || modes < 1 || modes > 2) return false;
+
+              BitReader modesReader(packet.data(), packet.size());
+              modesReader.skip(modesReader.left() - modesEnd);
+              blockFlags.resize(modes);
+              for(int mode = modes - 1; mode >= 0; --mode)
+              {
+                modesReader.skip(40);
+                blockFlags[mode] = modesReader.read(1);
+              }
+
+              // as vorbis_packet_blocksize().
+              for(auto value = modes; value > 1; value >>= 1)
+                ++modeBits;
+
+              // the audio begins in a new page.
+              if(i + 1 != page.segments) return false;
+            }
+            break;
+          default:
+            break;
+        }
+
+        ++headers;
+      }
+
+      packet.clear();
+    }
+
+    if(audio && page.granule != -1)
+    {
+      // pcm offset of the last packet of the first audio page, as _initial_pcmoffset() of libvorbis.
+      accumulated = page.granule - accumulated;
+      if(accumulated < 0) accumulated = 0;
+      break;
+    }
+
+    audio = (headers == 3);
+  }
+
+  Page last;
+  if(!readLastPage(wrapper, size, last) || last.serial != serial || last.granule < 0) return false;
+
+  data.channels = channels;
+  data.rate     = static_cast<int>(rate);
+  data.duration = static_cast<double>(std::max<long long>(last.granule - accumulated, 0)) / rate;
+
+  return true;
+}
@@ -0,0 +1,45 @@
+/*
+ File: VorbisProbe.h
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VORBISPROBE_H_
+#define VORBISPROBE_H_
+
+// Project
+#include <OGGContainerWrapper.h>
+
+/** \brief Reads the information of a Vorbis stream without decoding it. The channels and rate
+ *         are read from the identification header and the duration is the granule position of
+ *         the last page minus the initial offset of the first audio page, computed from the
+ *         block sizes of its packets as libvorbis does. The block size of every mode is found
+ *         at the end of the setup header without parsing the codebooks.
+ *
+ */
+namespace VorbisProbe
+{
+  /** \brief Fills the channels, rate and duration of the given stream and returns true, or returns
+   *         false if the stream is not a single Vorbis logical bitstream with valid pages that can
+   *         be probed, in which case it must be opened with libvorbis to get the information or the error.
+   * \param[inout] data OGG file data.
+   * \param[in] wrapper Wrapper of the stream.
+   *
+   */
+  bool probe(OGGData &data, OGGWrapper::OGGContainerWrapper &wrapper);
+}
+
+#endif // VORBISPROBE_H_
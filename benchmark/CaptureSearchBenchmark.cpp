@@ -0,0 +1,106 @@
+/*
+ File: CaptureSearchBenchmark.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <CaptureSearch.h>
+
+// C++
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+const size_t DATA_SIZE   = 256*1024*1024; /** 256 MB of data to search.       */
+const size_t PAGE_STRIDE = 4096;          /** distance between fake pages.     */
+const int    REPETITIONS = 5;             /** times each kernel is measured.   */
+
+/** \brief Measures the throughput of every kernel supported by the CPU on the given data.
+ * \param[in] data Data to search.
+ *
+ */
+void benchmarkKernels(const std::vector<unsigned char> &data)
+{
+  size_t reference = 0;
+  for(auto kernel: {CaptureSearch::Kernel::SCALAR, CaptureSearch::Kernel::SSE2, CaptureSearch::Kernel::AVX2, CaptureSearch::Kernel::AVX512})
+  {
+    const auto function = CaptureSearch::kernelFunction(kernel);
+    if(!function)
+    {
+      std::cout << std::setw(8) << CaptureSearch::kernelName(kernel) << ": not supported by this CPU." << std::endl;
+      continue;
+    }
+
+    double best = 0;
+    size_t found = 0;
+    for(int i = 0; i < REPETITIONS; ++i)
+    {
+      found = 0;
+      const auto start = std::chrono::steady_clock::now();
+
+      size_t position = 0;
+      while((position = function(data.data(), data.size(), position, data.size())) < data.size())
+      {
+        ++found;
+        ++position;
+      }
+
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      const auto throughput = data.size() / elapsed.count() / (1024.0*1024.0*1024.0);
+      best = std::max(best, throughput);
+    }
+
+    if(reference == 0) reference = found;
+
+    std::cout << std::setw(8) << CaptureSearch::kernelName(kernel) << ": " << std::fixed << std::setprecision(2) << best << " GB/s, "
+              << found << " candidates" << (found != reference ? " (MISMATCH)" : "") << std::endl;
+  }
+}
+
+/** \brief Micro-benchmark of the capture pattern search kernels. The data has a fake
+ *         page header every PAGE_STRIDE bytes, similar to an OGG stream, and is measured
+ *         once with random bytes and once with a high frequency of 'O' bytes, which is the
+ *         worst case for the scalar kernel.
+ *
+ */
+int main()
+{
+  std::vector<unsigned char> data(DATA_SIZE);
+  const unsigned char pattern[5] = { 'O', 'g', 'g', 'S', 0 };
+
+  std::cout << "Best kernel: " << CaptureSearch::kernelName(CaptureSearch::bestKernel()) << std::endl;
+
+  std::mt19937 generator(1234);
+  for(auto &value: data) value = static_cast<unsigned char>(generator());
+  for(size_t i = 0; i + sizeof(pattern) < DATA_SIZE; i += PAGE_STRIDE)
+    std::memcpy(data.data() + i, pattern, sizeof(pattern));
+
+  std::cout << "Random data:" << std::endl;
+  benchmarkKernels(data);
+
+  for(auto &value: data) value = (generator() % 4 == 0) ? 'O' : static_cast<unsigned char>(generator());
+  for(size_t i = 0; i + sizeof(pattern) < DATA_SIZE; i += PAGE_STRIDE)
+    std::memcpy(data.data() + i, pattern, sizeof(pattern));
+
+  std::cout << "Data with 25% 'O' bytes:" << std::endl;
+  benchmarkKernels(data);
+
+  return 0;
+}
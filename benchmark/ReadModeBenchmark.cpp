@@ -0,0 +1,88 @@
+/*
+ File: ReadModeBenchmark.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <ContainerScanner.h>
+
+// C++
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+/** \brief Returns the name of the given read mode.
+ * \param[in] mode Read mode.
+ *
+ */
+const char *modeName(const ReadMode mode)
+{
+  switch(mode)
+  {
+    case ReadMode::BUFFERED: return "buffered";
+    case ReadMode::MAPPED:   return "mapped";
+    case ReadMode::ASYNC:    return "async";
+    case ReadMode::DIRECT:   return "direct";
+    default: break;
+  }
+
+  return "unknown";
+}
+
+/** \brief Scans the given container once with every read mode and prints the throughput.
+ *         The first mode warms the system cache for the cached modes, the direct mode
+ *         always reads from the device. For cold cache numbers of a cached mode drop the
+ *         system cache and give only that mode with the second parameter.
+ *
+ */
+int main(int argc, char *argv[])
+{
+  if(argc < 2)
+  {
+    std::cout << "Usage: ReadModeBenchmark <container_file> [buffered|mapped|async|direct]" << std::endl;
+    return -1;
+  }
+
+  const std::filesystem::path container(argv[1]);
+  const std::string only = argc > 2 ? argv[2] : "";
+
+  for(auto mode: {ReadMode::BUFFERED, ReadMode::MAPPED, ReadMode::ASYNC, ReadMode::DIRECT})
+  {
+    if(!only.empty() && only != modeName(mode)) continue;
+
+    ContainerScanner scanner(container.wstring());
+    scanner.setReadMode(mode);
+
+    unsigned long long streams = 0;
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = scanner.scan([&streams](unsigned long long, unsigned long long) { ++streams; });
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if(!result)
+    {
+      std::cout << std::setw(8) << modeName(mode) << ": error " << scanner.error() << std::endl;
+      continue;
+    }
+
+    const auto throughput = scanner.size() / elapsed.count() / (1024.0*1024.0);
+    std::cout << std::setw(8) << modeName(mode) << ": " << std::fixed << std::setprecision(2) << throughput << " MB/s, "
+              << streams << " streams" << std::endl;
+  }
+
+  return 0;
+}
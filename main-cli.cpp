@@ -28,13 +28,24 @@
 #include <cstdlib>
 #include <iomanip>
 #include <set>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
 
 // Project
 #include <OGGContainerWrapper.h>
+#include <ContainerScanner.h>
+#include <CacheHints.h>
+#include <ScanCache.h>
+#include <FileCopy.h>
+#include <FileHandle.h>
+#include <StreamingScanner.h>
+#include <TarArchive.h>
 
 const std::string VERSION = "version 1.9.0";
-const long long BUFFER_SIZE = 5242880; /** 5 MB size buffer.     */
-const char *OGG_HEADER = "OggS";       /** Ogg header signature. */
 
 /** \class InputParser
  * \brief To parse arguments, modified from
@@ -185,6 +196,144 @@ std::string getOutputFilename(const int i, const OGGData &data, const unsigned l
   return sstr.str();
 }
 
+/** \brief Helper to extract the files of the container as soon as they are found, reading it only
+ * once. The data is written from the scan buffers when it fits in them, otherwise it's copied from the
+ * input file. Returns the number of extracted files.
+ * \param[in] input_file Input file or empty to read the standard input.
+ * \param[in] output_dir Output directory.
+ * \param[in] minSize Minimum size of the files in Kb.
+ * \param[in] minLength Minimum length of the files in seconds, only for input files.
+ * \param[in] rangeParser Positions of the files to extract, in the order they are found.
+ * \param[in] checksum True to verify the checksum of the pages.
+ * \param[in] bufferSize Maximum size of the input kept in memory.
+ * \param[in] durability When the files are flushed to the disk.
+ * \param[out] streams Found streams, with their information if it was read. Empty on read errors.
+ *
+ */
+unsigned int extractWhileScanning(const std::filesystem::path &input_file, const std::filesystem::path &output_dir,
+                                  const int minSize, const int minLength, const RangeParser &rangeParser, const bool checksum,
+                                  const unsigned long long bufferSize, const FileCopy::Durability durability,
+                                  std::vector<OGGData> &streams)
+{
+  const auto fromStdin = input_file.empty();
+  const auto container = fromStdin ? std::wstring(L"stdin") : input_file.wstring();
+  const unsigned long long totalSize = fromStdin ? 0 : std::filesystem::file_size(input_file);
+
+  std::shared_ptr<FileHandle> file;
+  if(fromStdin)
+  {
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+#endif
+  }
+  else
+  {
+    file = FileHandle::open(container);
+    if(!file)
+    {
+      std::cerr << "ERROR: Unable to open '" << input_file.string() << "' as readonly!" << std::endl;
+      return 0;
+    }
+  }
+
+  unsigned int extracted = 0;
+  std::filesystem::path last_file;
+
+  // the files are numbered in the order they end, as they are written then.
+  auto onStream = [&](unsigned long long start, unsigned long long end, const unsigned char *data)
+  {
+    OGGData stream;
+    stream.container = container;
+    stream.start     = start;
+    stream.end       = end;
+
+    streams.push_back(stream);
+    const auto i = static_cast<int>(streams.size() - 1);
+
+    if(minSize > 0 && (static_cast<unsigned long long>(minSize) * 1024 > (end - start)))
+      return;
+
+    if(rangeParser.count() > 0 && !rangeParser.isSelected(i+1))
+      return;
+
+    if(minLength > 0)
+    {
+      OGGWrapper::oggInfo(streams.back());
+      if(streams.back().duration < minLength)
+        return;
+    }
+
+    const auto output_file = output_dir / (std::to_string(i+1) + "_" + getOutputFilename(i, stream, totalSize));
+    const auto flush = (durability == FileCopy::Durability::FILE);
+
+    std::string error;
+    if(data)
+    {
+      std::ofstream output_stream(output_file, std::ios_base::out|std::ios_base::binary|std::ios_base::trunc);
+      output_stream.write(reinterpret_cast<const char *>(data), end - start);
+      output_stream.close();
+
+      if(output_stream.fail())
+        error = "Error writing the file.";
+      else if(flush)
+        FileCopy::flush(output_file.wstring(), error);
+    }
+    else if(file)
+    {
+      // didn't fit in memory, it's still in the input file.
+      FileCopy::copyRange(container, start, end, output_file.wstring(), error, nullptr, nullptr, flush);
+    }
+    else
+    {
+      error = "The input ended before the file or it didn't fit in memory.";
+    }
+
+    if(!error.empty())
+    {
+      std::cerr << "ERROR: Unable to write '" << output_file.string() << "'. " << error << std::endl;
+      return;
+    }
+
+    std::cout << "Wrote '" << output_file.string() << "'\n";
+    last_file = output_file;
+    ++extracted;
+  };
+
+  StreamingScanner scanner(onStream, bufferSize);
+  scanner.setChecksumValidation(checksum);
+
+  bool failed = false;
+  std::vector<unsigned char> buffer(8 * 1024 * 1024);
+  while(true)
+  {
+    long long bytesRead = 0;
+    if(file)
+      bytesRead = file->read(buffer.data(), buffer.size(), scanner.processed());
+    else
+      bytesRead = std::fread(buffer.data(), 1, buffer.size(), stdin);
+
+    failed = (bytesRead < 0) || (!file && std::ferror(stdin));
+    if(bytesRead <= 0) break;
+
+    scanner.scan(buffer.data(), bytesRead);
+  }
+
+  if(failed)
+    std::cerr << "ERROR: I/O Error reading the " << (fromStdin ? std::string("standard input") : "file '" + input_file.string() + "'")
+              << " after " << scanner.processed() << " bytes." << std::endl;
+
+  scanner.finish();
+
+  // the results of an incomplete scan can't be stored.
+  if(failed) streams.clear();
+
+  std::string error;
+  if(durability == FileCopy::Durability::GROUP && !last_file.empty() && !FileCopy::flushFileSystem(last_file.wstring(), error))
+    std::cerr << "ERROR: Unable to flush the extracted files. " << error << std::endl;
+
+  return extracted;
+}
+
 /** \brief Helper to print help to console.
  *
  */
@@ -196,10 +345,28 @@ void print_help()
   std::cout << "\t-s <number>      Minimum size of files to extract in Kb.\n";
   std::cout << "\t-l <number>      Minimum length in seconds of files to extract.\n";
   std::cout << "\t-o <output_dir>  Output directory for extracted files.\n";
-  std::cout << "\t-i <input_file>  Input file to scan for OGG files.\n";
+  std::cout << "\t-i <input_file>  Input file to scan for OGG files, - to read it from the standard input.\n";
   std::cout << "\t-d               Dump file information in a CSV file and do not extract files.\n";
   std::cout << "\t-r <range_def>   Extract files in the given position/range (comma separated values and ranges like low-upp).\n";
-  std::cout << "\t                 Specified positions are absolute, not relative to filtering by size or length.\n\n";
+  std::cout << "\t                 Specified positions are absolute, not relative to filtering by size or length.\n";
+  std::cout << "\t--threads <N>    Number of threads to scan the input file in parallel chunks (default 1).\n";
+  std::cout << "\t--crc            Verify the checksum of the pages to ignore false positives.\n";
+  std::cout << "\t--io <mode>      Input file read mode: async (default), direct (bypass the system cache), mapped or buffered.\n";
+  std::cout << "\t--polite <MB>    Keep at most the given size of the input file in the system cache while scanning and\n";
+  std::cout << "\t                 release the extracted data from the cache, to not disturb other programs.\n";
+  std::cout << "\t--resume         Continue the interrupted scan of the input file instead of scanning it again.\n";
+  std::cout << "\t--rescan         Scan the input file even if the results of a previous scan are stored.\n";
+  std::cout << "\t--sequential     Extract all the files reading the input file once from start to end, for hard\n";
+  std::cout << "\t                 disks and optical images where seeking between the files is slow.\n";
+  std::cout << "\t--jobs <N>       Number of files extracted at the same time (default 1), ignored with --sequential.\n";
+  std::cout << "\t--budget <MB>    Maximum size of the files extracted at the same time (default 256, 0 for no limit).\n";
+  std::cout << "\t--sync <mode>    Flush the extracted files to the disk: none (default, left to the system), group (once\n";
+  std::cout << "\t                 for the whole file system at the end) or file (every file when written).\n";
+  std::cout << "\t--tar <file>     Write the files to the given uncompressed tar archive instead of the output directory.\n";
+  std::cout << "\t                 Its first member, " << TarArchive::INDEX_NAME << ", has the position and size of the data of the rest.\n";
+  std::cout << "\t--buffer <MB>    Maximum size of the input kept in memory for the files being read (default 1024).\n";
+  std::cout << "\t--pipeline       Extract the files while scanning, reading the input file only once. The files are numbered\n";
+  std::cout << "\t                 in the order they are found. Without effect if the results of a previous scan are used.\n\n";
   std::cout << "Example: OGGExtractor-cli.exe -o D:\\output_dir\\ -s 100 -l 60 -i container_file.ext\n\n";
   std::cout << "\tExtracts all files inside container_file.ext with a size over 100Kb and a duration over 60 seconds\n";
   std::cout << "\tin the directory D:\\output_dir\\.\n\n";
@@ -227,7 +394,21 @@ int main(int argc, char *argv[])
   int minLength = 0;
   std::filesystem::path output_dir = std::filesystem::current_path();
   std::filesystem::path input_file;
+  std::filesystem::path archive_file;
   bool dumpCSV = false;
+  unsigned int threads = 1;
+  bool checksum = false;
+  ReadMode readMode = ReadMode::ASYNC;
+  unsigned long long cacheWindow = 0;
+  bool resume = false;
+  bool rescan = false;
+  bool sequential = false;
+  unsigned int jobs = 1;
+  unsigned long long budget = 256 * 1024 * 1024;
+  bool readStdin = false;
+  bool pipeline = false;
+  unsigned long long bufferSize = StreamingScanner::DEFAULT_BUFFER_SIZE;
+  FileCopy::Durability durability = FileCopy::Durability::NONE;
   RangeParser rangeParser;
 
   // Parse arguments and fill parameter variables.
@@ -250,6 +431,11 @@ int main(int argc, char *argv[])
   }
 
   dumpCSV = parser.cmdOptionExists("-d");
+  checksum = parser.cmdOptionExists("--crc");
+  resume = parser.cmdOptionExists("--resume");
+  rescan = parser.cmdOptionExists("--rescan");
+  sequential = parser.cmdOptionExists("--sequential");
+  pipeline = parser.cmdOptionExists("--pipeline");
 
   if(parser.cmdOptionExists("-l"))
   {
@@ -265,6 +451,103 @@ int main(int argc, char *argv[])
     }
   }
 
+  if(parser.cmdOptionExists("--threads"))
+  {
+    char *ptr = nullptr;
+    const auto value = parser.getCmdOption("--threads");
+    const auto tempThreads = std::strtol(value.c_str(), &ptr, 10);
+    if(ptr != nullptr && tempThreads > 0)
+      threads = tempThreads;
+    else
+    {
+      std::cerr << "ERROR - Invalid number of threads: " << value << std::endl;
+      print_help();
+    }
+  }
+
+  if(parser.cmdOptionExists("--jobs"))
+  {
+    char *ptr = nullptr;
+    const auto value = parser.getCmdOption("--jobs");
+    const auto tempJobs = std::strtol(value.c_str(), &ptr, 10);
+    if(ptr != nullptr && tempJobs > 0)
+      jobs = tempJobs;
+    else
+    {
+      std::cerr << "ERROR - Invalid number of extraction jobs: " << value << std::endl;
+      print_help();
+    }
+  }
+
+  if(parser.cmdOptionExists("--budget"))
+  {
+    char *ptr = nullptr;
+    const auto value = parser.getCmdOption("--budget");
+    const auto tempBudget = std::strtol(value.c_str(), &ptr, 10);
+    if(ptr != nullptr && tempBudget >= 0)
+      budget = static_cast<unsigned long long>(tempBudget) * 1024 * 1024;
+    else
+    {
+      std::cerr << "ERROR - Invalid extraction budget: " << value << std::endl;
+      print_help();
+    }
+  }
+
+  if(parser.cmdOptionExists("--sync"))
+  {
+    const auto value = parser.getCmdOption("--sync");
+    if(value == "none")       durability = FileCopy::Durability::NONE;
+    else if(value == "group") durability = FileCopy::Durability::GROUP;
+    else if(value == "file")  durability = FileCopy::Durability::FILE;
+    else
+    {
+      std::cerr << "ERROR - Invalid sync mode: " << value << std::endl;
+      print_help();
+    }
+  }
+
+  if(parser.cmdOptionExists("--buffer"))
+  {
+    char *ptr = nullptr;
+    const auto value = parser.getCmdOption("--buffer");
+    const auto tempBuffer = std::strtol(value.c_str(), &ptr, 10);
+    if(ptr != nullptr && tempBuffer > 0)
+      bufferSize = static_cast<unsigned long long>(tempBuffer) * 1024 * 1024;
+    else
+    {
+      std::cerr << "ERROR - Invalid buffer size: " << value << std::endl;
+      print_help();
+    }
+  }
+
+  if(parser.cmdOptionExists("--io"))
+  {
+    const auto value = parser.getCmdOption("--io");
+    if(value == "async")         readMode = ReadMode::ASYNC;
+    else if(value == "direct")   readMode = ReadMode::DIRECT;
+    else if(value == "mapped")   readMode = ReadMode::MAPPED;
+    else if(value == "buffered") readMode = ReadMode::BUFFERED;
+    else
+    {
+      std::cerr << "ERROR - Invalid read mode: " << value << std::endl;
+      print_help();
+    }
+  }
+
+  if(parser.cmdOptionExists("--polite"))
+  {
+    char *ptr = nullptr;
+    const auto value = parser.getCmdOption("--polite");
+    const auto tempWindow = std::strtol(value.c_str(), &ptr, 10);
+    if(ptr != nullptr && tempWindow > 0)
+      cacheWindow = static_cast<unsigned long long>(tempWindow) * 1024 * 1024;
+    else
+    {
+      std::cerr << "ERROR - Invalid cache window size: " << value << std::endl;
+      print_help();
+    }
+  }
+
   if(parser.cmdOptionExists("-o"))
   {
     const auto temp_path = std::filesystem::path(parser.getCmdOption("-o"));
@@ -280,7 +563,9 @@ int main(int argc, char *argv[])
   if(parser.cmdOptionExists("-i"))
   {
     const auto temp_path = std::filesystem::path(parser.getCmdOption("-i"));
-    if(std::filesystem::exists(temp_path) && !std::filesystem::is_directory(temp_path))
+    if(temp_path == "-")
+      readStdin = true;
+    else if(std::filesystem::exists(temp_path) && !std::filesystem::is_directory(temp_path))
       input_file = std::filesystem::canonical(temp_path);
     else
     {
@@ -289,6 +574,18 @@ int main(int argc, char *argv[])
     }
   }
 
+  if(parser.cmdOptionExists("--tar"))
+  {
+    const auto temp_path = std::filesystem::path(parser.getCmdOption("--tar"));
+    if(!temp_path.empty() && !std::filesystem::is_directory(temp_path))
+      archive_file = std::filesystem::absolute(temp_path);
+    else
+    {
+      std::cerr << "ERROR - Invalid archive file: " << temp_path << std::endl;
+      print_help();
+    }
+  }
+
   if(parser.cmdOptionExists("-r"))
   {
     rangeParser = RangeParser(parser.getCmdOption("-r"));
@@ -302,12 +599,35 @@ int main(int argc, char *argv[])
     print_help();
   }
 
+  if(readStdin)
+  {
+    // the information of the streams and the stored scans need a file.
+    if(dumpCSV || minLength > 0 || !archive_file.empty() || resume)
+    {
+      std::cerr << "ERROR: The -d, -l, --tar and --resume options need an input file, not the standard input." << std::endl;
+      print_help();
+    }
+
+    std::vector<OGGData> streams;
+    const auto extracted = extractWhileScanning(std::filesystem::path(), output_dir, minSize, 0, rangeParser, checksum, bufferSize, durability, streams);
+    std::cout << "Extracted " << extracted << " files according to given parameters." << std::endl;
+
+    return 0;
+  }
+
   if(input_file.empty())
   {
     std::cerr << "ERROR: An input file is necessary to scan!" << std::endl;
     print_help();
   }
 
+  // the files are written during the scan, before the rest of the streams are known.
+  if(pipeline && (dumpCSV || !archive_file.empty() || resume))
+  {
+    std::cerr << "ERROR: The -d, --tar and --resume options can't be used with --pipeline." << std::endl;
+    print_help();
+  }
+
   std::ifstream input_stream(input_file.c_str(), std::ios_base::in|std::ios_base::binary);
   if(!input_stream.is_open())
   {
@@ -326,101 +646,22 @@ int main(int argc, char *argv[])
   }
 
   // All done, begin scanning
-  auto buffer = new unsigned char[BUFFER_SIZE];
-  long long processed = 0;
-  unsigned long long oggBeginning = 0;
-  unsigned long long oggEnding    = 0;
-
-  bool beginFound = false;
-  bool endFound   = false;
-
-  unsigned char oggHeader[27];
   int progressValue = 0;
   std::vector<OGGData> streams;
 
-  while (true)
+  // the information of the streams is read after the scan.
+  auto addStream = [&streams, &input_file](unsigned long long start, unsigned long long end)
   {
-    input_stream.seekg(processed);
-
-    input_stream.read(reinterpret_cast<char *>(buffer), BUFFER_SIZE);
-    auto bytesRead = input_stream.gcount();
-
-    if(bytesRead < BUFFER_SIZE) // reset fail bit if reached the end.
-      input_stream.clear(std::ios_base::goodbit);
+    OGGData data;
+    data.container = input_file.wstring();
+    data.start     = start;
+    data.end       = end;
 
-    for (long long loop = 0; loop < bytesRead && 0 != bytesRead; ++loop)
-    {
-      // check for "OggS" header and flags
-      if (buffer[loop] == 0x4F)
-      {
-        input_stream.seekg(processed + loop);
-        input_stream.read(reinterpret_cast<char *>(&oggHeader[0]), sizeof(oggHeader));
-        unsigned long long readResult = input_stream.gcount();
-        if(!input_stream || sizeof(oggHeader) != readResult)
-        {
-          std::cerr << "ERROR: I/O Error scanning file '" << input_file.string() << "' at position " << processed + loop << "." << std::endl;
-          std::exit(-1);
-        }
-
-        if (0 == (strncmp((const char *) oggHeader, OGG_HEADER, 4)))
-        {
-          // detected beginning of ogg file
-          if (oggHeader[5] & 0x02)
-          {
-            beginFound = true;
-            oggBeginning = processed + loop;
-            continue;
-          }
-
-          // detected ending of ogg file, more difficult because of trailing frames
-          if (beginFound && (oggHeader[5] & 0x04))
-          {
-            endFound = true;
-            oggEnding = processed + loop + sizeof(oggHeader);
-
-            const auto trailingSize   = static_cast<size_t>(oggHeader[26]);
-            const auto trailingFrames = new unsigned char[trailingSize];
-
-            input_stream.seekg(oggEnding);
-            input_stream.read(reinterpret_cast<char*>(trailingFrames), trailingSize);
-            readResult = input_stream.gcount();
-
-            if (!input_stream || (trailingSize != readResult))
-            {
-              std::cerr << "ERROR: I/O error reading file'" << input_file.string() << ", probably tried to read past EOF." << std::endl;
-              std::exit(-1);
-            }
-
-            oggEnding += trailingSize;
-
-            for (unsigned int i = 0; i < trailingSize; i++)
-            {
-              const unsigned char lacingValue = trailingFrames[i];
-              oggEnding += static_cast<unsigned int>(lacingValue);
-            }
-
-            delete [] trailingFrames;
-          }
-
-          if ((beginFound == true) && (endFound == true))
-          {
-            beginFound = endFound = false;
-
-            OGGData data;
-            data.container = input_file.wstring();
-            data.start     = oggBeginning;
-            data.end       = oggEnding;
-
-            OGGWrapper::oggInfo(data);
-
-            streams.push_back(data);
-          }
-        }
-      }
-    }
-
-    processed += bytesRead;
+    streams.push_back(data);
+  };
 
+  auto showProgress = [&progressValue, &streams, &input_file, &totalSize](unsigned long long processed)
+  {
     const int value = 100.0*(static_cast<double>(processed)/totalSize);
     if(value != progressValue)
     {
@@ -428,10 +669,66 @@ int main(int argc, char *argv[])
       std::cout << "\rScanning '" << input_file.string() << "': " << progressValue << "% - Found " << streams.size() << " files.";
     }
 
-    // check for eof
-    if(processed == totalSize) break;
+    return true;
+  };
+
+  ScanCache cache(input_file.wstring());
+  cache.setChecksumValidation(checksum);
+
+  bool updated = false;
+  if(!rescan && cache.load(streams))
+  {
+    std::cout << "Found " << streams.size() << " files in the results of a previous scan of '" << input_file.string() << "'." << std::endl;
   }
-  std::cout << std::endl;
+  else if(pipeline)
+  {
+    // one read of the input, the files are written from the scan buffers as soon as they end.
+    const auto extracted = extractWhileScanning(input_file, output_dir, minSize, minLength, rangeParser, checksum, bufferSize, durability, streams);
+    if(!streams.empty()) cache.save(streams);
+
+    std::cout << "Extracted " << extracted << " files according to given parameters." << std::endl;
+
+    return 0;
+  }
+  else
+  {
+    ContainerScanner scanner(input_file.wstring());
+    scanner.setThreads(threads);
+    scanner.setReadMode(readMode);
+    scanner.setChecksumValidation(checksum);
+    scanner.setCacheWindow(cacheWindow);
+    scanner.setCheckpoints(true);
+    scanner.setResume(resume);
+    if(!scanner.scan(addStream, showProgress))
+    {
+      std::cerr << "\nERROR: I/O Error scanning file '" << input_file.string() << "'. " << scanner.error() << std::endl;
+      std::cerr << "The scan can be continued with the --resume option." << std::endl;
+      std::exit(-1);
+    }
+    std::cout << std::endl;
+
+    if(scanner.resumedPosition() > 0)
+      std::cout << "Resumed the interrupted scan at position " << scanner.resumedPosition() << "." << std::endl;
+
+    updated = true;
+  }
+
+  // page faults of the mapping read ahead a lot more than the information needs. The streams stored
+  // by the interface may not have the information.
+  auto onInfo = [&cacheWindow](const OGGData &data)
+  {
+    if(cacheWindow > 0) CacheHints::drop(data.container, data.start, data.end);
+  };
+
+  if(OGGWrapper::oggInfo(streams, 0, cacheWindow == 0, onInfo))
+  {
+    // the kept handles read ahead after the end of the streams.
+    if(cacheWindow > 0) CacheHints::drop(input_file.wstring());
+
+    updated = true;
+  }
+
+  if(updated) cache.save(streams);
 
   // Input scanned, apply filters and dump data.
 
@@ -463,10 +760,9 @@ int main(int argc, char *argv[])
   }
 
   // Extract files.
-  unsigned int extracted = 0;
+  std::vector<FileCopy::Range> ranges;
   for(int i = 0; i < streams.size(); ++i)
   {
-    input_stream.clear(std::ios_base::goodbit);
     const auto &data = streams.at(i);
 
     if(minSize > 0 && (minSize * 1024 > (data.end-data.start)))
@@ -478,8 +774,6 @@ int main(int argc, char *argv[])
     if(rangeParser.count() > 0 && !rangeParser.isSelected(i+1))
       continue;
 
-    input_stream.seekg(data.start);
-
     std::stringstream numstr;
     numstr.width(std::to_string(streams.size()).length());
     numstr.fill('0');
@@ -487,27 +781,96 @@ int main(int argc, char *argv[])
 
     auto output_file = output_dir / (std::string(numstr.str()) + getOutputFilename(i, data, totalSize));
 
-    // Beware Trucate
-    std::ofstream output_stream(output_file.c_str(), std::ios_base::out|std::ios_base::binary|std::ios_base::trunc);
+    ranges.push_back(FileCopy::Range{data.start, data.end, output_file.wstring()});
+  }
+
+  unsigned int extracted = 0;
+  auto onExtracted = [&ranges, &extracted, &input_file, &cacheWindow](size_t i, const std::string &error)
+  {
+    const auto &range = ranges.at(i);
+    const auto output_file = std::filesystem::path(range.destination);
 
-    auto remaining = data.end-data.start;
-    while(remaining > BUFFER_SIZE)
+    if(!error.empty())
     {
-      input_stream.read(reinterpret_cast<char*>(buffer), BUFFER_SIZE);
-      remaining -= BUFFER_SIZE;
-      output_stream.write(reinterpret_cast<char*>(buffer), BUFFER_SIZE);
+      std::cerr << "ERROR: Unable to write '" << output_file.string() << "'. " << error << std::endl;
+      return;
     }
 
-    input_stream.read(reinterpret_cast<char*>(buffer), remaining);
-    output_stream.write(reinterpret_cast<char*>(buffer), remaining);
-    output_stream.close();
+    if(cacheWindow > 0)
+    {
+      CacheHints::drop(input_file.wstring(), range.begin, range.end);
+      CacheHints::dropWritten(range.destination);
+    }
 
     std::cout << "Wrote '" << output_file.string() << "'\n";
     ++extracted;
+  };
+
+  if(!archive_file.empty())
+  {
+    // one sequential write, the names are the same as the files.
+    std::vector<TarArchive::Member> members;
+    for(const auto &range: ranges)
+    {
+      const auto name = std::filesystem::path(range.destination).filename().string();
+      members.push_back(TarArchive::Member{name, input_file.wstring(), range.begin, range.end});
+    }
+
+    auto onArchived = [&members, &extracted, &input_file, &cacheWindow](size_t i, const std::string &error)
+    {
+      const auto &member = members.at(i);
+      if(!error.empty())
+      {
+        std::cerr << "ERROR: Unable to read the data of '" << member.name << "'. " << error << std::endl;
+        return;
+      }
+
+      if(cacheWindow > 0) CacheHints::drop(input_file.wstring(), member.begin, member.end);
+
+      ++extracted;
+    };
+
+    std::string error;
+    if(TarArchive::write(archive_file.wstring(), members, error, onArchived, nullptr, durability != FileCopy::Durability::NONE))
+    {
+      if(cacheWindow > 0) CacheHints::dropWritten(archive_file.wstring());
+
+      std::cout << "Wrote '" << archive_file.string() << "'\n";
+
+      if(!error.empty())
+        std::cerr << "ERROR: Unable to flush '" << archive_file.string() << "'. " << error << std::endl;
+    }
+    else
+    {
+      std::cerr << "ERROR: Unable to write '" << archive_file.string() << "'. " << error << std::endl;
+      extracted = 0;
+    }
   }
-  std::cout << "Extracted " << extracted << " files according to given parameters." << std::endl;
+  else if(sequential)
+  {
+    // one forward pass over the input, the errors are reported per file.
+    std::string error;
+    if(!FileCopy::copyRanges(input_file.wstring(), ranges, error, onExtracted, nullptr, durability == FileCopy::Durability::FILE) && !error.empty())
+      std::cerr << "ERROR: Unable to extract the files. " << error << std::endl;
+  }
+  else
+  {
+    // Beware Trucate. The data is copied by the system when possible.
+    std::string error;
+    FileCopy::copyParallel(input_file.wstring(), ranges, jobs, budget, error, onExtracted, nullptr, durability == FileCopy::Durability::FILE);
+  }
+
+  // one flush for all the files, any of them is on the file system. The archive is flushed when written.
+  if(archive_file.empty() && durability == FileCopy::Durability::GROUP)
+  {
+    auto written = std::find_if(ranges.cbegin(), ranges.cend(), [](const FileCopy::Range &range) { return std::filesystem::exists(range.destination); });
 
-  delete [] buffer;
+    std::string error;
+    if(written != ranges.cend() && !FileCopy::flushFileSystem(written->destination, error))
+      std::cerr << "ERROR: Unable to flush the extracted files. " << error << std::endl;
+  }
+
+  std::cout << "Extracted " << extracted << " files according to given parameters." << std::endl;
 
   return 0;
 }
@@ -0,0 +1,124 @@
+/*
+ File: OGGScannerTest.cpp
+ Created on: 17/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <OGGScanner.h>
+#include <PageChecksum.h>
+
+// C++
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Range = std::pair<unsigned long long, unsigned long long>;
+
+/** \brief Appends an Ogg page with the given values and a body of the given size to the data.
+ * \param[inout] data Container data.
+ * \param[in] serial Bitstream serial number.
+ * \param[in] flags Header type flags.
+ * \param[in] sequence Page sequence number.
+ * \param[in] bodySize Size of the page body.
+ *
+ */
+void addPage(std::vector<unsigned char> &data, const uint32_t serial, const unsigned char flags, const uint32_t sequence, const size_t bodySize)
+{
+  std::vector<unsigned char> page{'O', 'g', 'g', 'S', 0, flags};
+  page.resize(26, 0);
+
+  for(int i = 0; i < 4; ++i)
+  {
+    page[14 + i] = static_cast<unsigned char>(serial >> (8 * i));
+    page[18 + i] = static_cast<unsigned char>(sequence >> (8 * i));
+  }
+
+  std::vector<unsigned char> lacing(bodySize / 255, 255);
+  lacing.push_back(static_cast<unsigned char>(bodySize % 255));
+
+  page.push_back(static_cast<unsigned char>(lacing.size()));
+  page.insert(page.end(), lacing.cbegin(), lacing.cend());
+  for(size_t i = 0; i < bodySize; ++i)
+    page.push_back(static_cast<unsigned char>(i * 7 + sequence));
+
+  const auto crc = PageChecksum::compute(page.data(), page.size());
+  for(int i = 0; i < 4; ++i)
+    page[22 + i] = static_cast<unsigned char>(crc >> (8 * i));
+
+  data.insert(data.end(), page.cbegin(), page.cend());
+}
+
+/** \brief Returns the streams found in the given data, scanned in blocks of the given size.
+ * \param[in] data Container data.
+ * \param[in] blockSize Block size in bytes.
+ * \param[in] walking True to follow the chain of pages.
+ *
+ */
+std::vector<Range> scan(const std::vector<unsigned char> &data, const size_t blockSize, const bool walking)
+{
+  std::vector<Range> result;
+  OGGScanner scanner([&result](unsigned long long start, unsigned long long end) { result.emplace_back(start, end); });
+  scanner.setPageWalking(walking);
+
+  for(size_t position = 0; position < data.size(); position += blockSize)
+    scanner.scan(data.data() + position, std::min(blockSize, data.size() - position));
+
+  scanner.finish();
+
+  return result;
+}
+
+//----------------------------------------------------------------
+int main()
+{
+  // a stream cut in the middle of a page, followed by a complete stream.
+  std::vector<unsigned char> data(1000, 0x55);
+
+  addPage(data, 1, 0x02, 0, 30);
+  for(uint32_t i = 1; i < 5; ++i) addPage(data, 1, 0x00, i, 3000);
+
+  std::vector<unsigned char> truncated;
+  addPage(truncated, 1, 0x00, 5, 4000);
+  data.insert(data.end(), truncated.cbegin(), truncated.cbegin() + 500);
+
+  const auto begin = data.size();
+  addPage(data, 2, 0x02, 0, 30);
+  for(uint32_t i = 1; i < 5; ++i) addPage(data, 2, 0x00, i, 3000);
+  addPage(data, 2, 0x04, 5, 1000);
+  const auto end = data.size();
+
+  data.resize(data.size() + 1000, 0x55);
+
+  const std::vector<Range> expected{Range{begin, end}};
+
+  int failures = 0;
+  for(const auto walking: {false, true})
+  {
+    for(const size_t blockSize: {data.size(), size_t{4096}, size_t{1000}, size_t{7}})
+    {
+      if(scan(data, blockSize, walking) != expected)
+      {
+        std::cerr << "FAILED: stream after a truncated page, walking " << walking << ", blocks of " << blockSize << " bytes." << std::endl;
+        ++failures;
+      }
+    }
+  }
+
+  return failures == 0 ? 0 : 1;
+}